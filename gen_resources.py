@@ -1,4 +1,6 @@
 import os
+import struct
+import argparse
 import collections
 from pathlib import Path
 from xml.etree import ElementTree as xmlET
@@ -22,6 +24,27 @@ DS3_INVENTORY_DIRS = {
     "item_icons",
 }
 ER_INVENTORY_DIRS = set()
+# Inventory resources which can be stored in asset pack instead of qrc
+PACK_RESOURCES = (
+    "dsr_inv_images.qrc",
+    "ds3_inv_images.qrc",
+)
+# Sizes in physical pixels used by inventory delegates (1x and 2x device pixel ratio)
+# - key is name of directory with images, 'None' is used for other directories
+ATLAS_SIZES = {
+    "dsr_inv_images.qrc": {
+        "infusions": (24, 48),
+        None: (60, 120),
+    },
+    "ds3_inv_images.qrc": {
+        "infusion_icons": (24, 48),
+        None: (80, 160),
+    },
+}
+ATLAS_PAGE_SIZE = 2048
+PACK_MAGIC = b"FSSMPACK"
+PACK_VERSION = 1
+PACK_ALIGNMENT = 8
 
 
 def _fill_files(
@@ -157,8 +180,216 @@ def create_er_resources(resources_dir: Path) -> None:
     )
 
 
+def _collect_pack_files(
+    resources_dir: Path,
+    filenames: tuple[str, ...] = PACK_RESOURCES,
+) -> list[tuple[str, Path]]:
+    files: list[tuple[str, Path]] = []
+    for filename in filenames:
+        qrc_path = resources_dir / filename
+        if not qrc_path.exists():
+            continue
+        root = xmlET.parse(str(qrc_path)).getroot()
+        for qresource in root.iter("qresource"):
+            prefix = qresource.attrib.get("prefix", "").strip("/")
+            for file_el in qresource.iter("file"):
+                alias = file_el.attrib.get("alias", file_el.text)
+                key = f"{prefix}/{alias}" if prefix else alias
+                files.append((key, resources_dir / file_el.text))
+    return files
+
+
+def create_asset_pack(resources_dir: Path, pack_path: Path) -> None:
+    """Store inventory resources to single file that is memory mapped by app.
+
+    Layout (little endian):
+        magic (8 bytes), version (u32), entry count (u32)
+        entries sorted by key: key length (u16), key (utf-8),
+            data offset from file start (u64), data size (u64)
+        data of files, each aligned to 8 bytes
+    Keys are resource paths without ':/' prefix, e.g. 'ds3_inv_images/affinity'.
+    """
+    files = sorted(_collect_pack_files(resources_dir), key=lambda x: x[0])
+    encoded_keys = [key.encode("utf-8") for key, _ in files]
+
+    index_size = 16 + sum(2 + len(key) + 16 for key in encoded_keys)
+    offset = index_size
+    entries: list[tuple[bytes, int, int]] = []
+    blobs: list[bytes] = []
+    for key, (_, path) in zip(encoded_keys, files):
+        offset += -offset % PACK_ALIGNMENT
+        data = path.read_bytes()
+        entries.append((key, offset, len(data)))
+        blobs.append(data)
+        offset += len(data)
+
+    pack_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(pack_path, "wb") as stream:
+        stream.write(PACK_MAGIC)
+        stream.write(struct.pack("<II", PACK_VERSION, len(entries)))
+        for key, data_offset, data_size in entries:
+            stream.write(struct.pack("<H", len(key)))
+            stream.write(key)
+            stream.write(struct.pack("<QQ", data_offset, data_size))
+
+        for (_, data_offset, _), data in zip(entries, blobs):
+            stream.write(b"\0" * (data_offset - stream.tell()))
+            stream.write(data)
+
+
+def _write_atlas_pages(
+    files: list[tuple[str, Path]],
+    size: int,
+    page_prefix: str,
+    output_dir: Path,
+) -> list[tuple[str, int, int, int, int, int, int]]:
+    # Imported here so Pillow is required only for atlas generation
+    from PIL import Image
+
+    per_row = ATLAS_PAGE_SIZE // size
+    per_page = per_row * per_row
+    entries = []
+    for page_idx in range(0, (len(files) + per_page - 1) // per_page):
+        page_files = files[page_idx * per_page:(page_idx + 1) * per_page]
+        rows = (len(page_files) + per_row - 1) // per_row
+        columns = min(len(page_files), per_row)
+        page = Image.new("RGBA", (columns * size, rows * size))
+        for idx, (key, path) in enumerate(page_files):
+            with Image.open(path) as image:
+                image = image.convert("RGBA")
+                # Keep aspect ratio, same as 'Qt::KeepAspectRatio'
+                ratio = min(size / image.width, size / image.height)
+                image = image.resize(
+                    (
+                        max(1, round(image.width * ratio)),
+                        max(1, round(image.height * ratio)),
+                    ),
+                    Image.Resampling.LANCZOS,
+                )
+                x = (idx % per_row) * size
+                y = (idx // per_row) * size
+                page.paste(image, (x, y))
+                entries.append(
+                    (key, size, page_idx, x, y, image.width, image.height)
+                )
+        page.save(output_dir / f"{page_prefix}_{size}_{page_idx}.png")
+    return entries
+
+
+def create_inventory_atlas(resources_dir: Path, output_dir: Path) -> None:
+    """Create atlases of pre-downscaled inventory images.
+
+    Writes atlas pages, 'inv_atlas.qrc' with prefix '/inv_atlas' and
+    'InvAtlasIndex.h' mapping resource keys to rectangles in atlas pages.
+    """
+    pages_dir = output_dir / "inv_atlas"
+    pages_dir.mkdir(parents=True, exist_ok=True)
+    for path in pages_dir.glob("*.png"):
+        path.unlink()
+
+    entries = []
+    for filename, sizes_by_dir in ATLAS_SIZES.items():
+        files_by_dir: dict[str, list[tuple[str, Path]]] = (
+            collections.defaultdict(list)
+        )
+        used_keys: set[str] = set()
+        for key, path in _collect_pack_files(resources_dir, (filename,)):
+            # Same alias may be used in multiple directories
+            if key in used_keys:
+                continue
+            used_keys.add(key)
+            dirname = path.parent.name
+            if dirname not in sizes_by_dir:
+                dirname = None
+            files_by_dir[dirname].append((key, path))
+
+        prefix = filename.removesuffix(".qrc")
+        for dirname, files in files_by_dir.items():
+            files.sort(key=lambda x: x[0])
+            page_prefix = prefix if dirname is None else f"{prefix}_{dirname}"
+            for size in sizes_by_dir[dirname]:
+                entries.extend(
+                    (page_prefix, *entry)
+                    for entry in _write_atlas_pages(
+                        files, size, page_prefix, pages_dir
+                    )
+                )
+
+    qrc_el: xmlET.Element = xmlET.Element("qresource", prefix="/inv_atlas")
+    for path in sorted(pages_dir.glob("*.png")):
+        item: xmlET.Element = xmlET.Element("file", alias=path.stem)
+        item.text = f"inv_atlas/{path.name}"
+        qrc_el.append(item)
+    qrc_root = xmlET.Element("RCC")
+    qrc_root.append(qrc_el)
+    tree: xmlET.ElementTree = xmlET.ElementTree(qrc_root)
+    xmlET.indent(tree, INDENT_SPACES)
+    tree.write(str(output_dir / "inv_atlas.qrc"), encoding="utf-8")
+
+    # Sorted by key and size for binary search
+    entries.sort(key=lambda x: (x[1], x[2]))
+    lines = [
+        "// Generated by gen_resources.py, do not modify",
+        "#pragma once",
+        "#include <array>",
+        "#include <string_view>",
+        "",
+        "namespace fssm::ui {",
+        "struct AtlasSprite {",
+        f"{INDENT_SPACES}std::string_view key;",
+        f"{INDENT_SPACES}int size;",
+        f"{INDENT_SPACES}std::string_view page;",
+        f"{INDENT_SPACES}int x;",
+        f"{INDENT_SPACES}int y;",
+        f"{INDENT_SPACES}int width;",
+        f"{INDENT_SPACES}int height;",
+        "};",
+        "",
+        (
+            "inline constexpr std::array<AtlasSprite, "
+            f"{len(entries)}> INV_ATLAS_SPRITES = {{{{"
+        ),
+    ]
+    for page_prefix, key, size, page_idx, x, y, width, height in entries:
+        page = f"{page_prefix}_{size}_{page_idx}"
+        lines.append(
+            f'{INDENT_SPACES}{{"{key}", {size}, "{page}",'
+            f" {x}, {y}, {width}, {height}}},"
+        )
+    lines.extend(["}};", "}", ""])
+    (output_dir / "InvAtlasIndex.h").write_text(
+        "\n".join(lines), encoding="utf-8"
+    )
+
+
 def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--pack",
+        type=Path,
+        help=(
+            "Write inventory resources from existing qrc files"
+            " to asset pack instead of regenerating qrc files."
+        ),
+    )
+    parser.add_argument(
+        "--atlas",
+        type=Path,
+        help=(
+            "Write atlases of pre-downscaled inventory images with C++ index"
+            " to the directory. Requires Pillow."
+        ),
+    )
+    args = parser.parse_args()
+
     resources_dir = CURRENT_DIR / "src" / "resources"
+    if args.pack or args.atlas:
+        if args.pack:
+            create_asset_pack(resources_dir, args.pack)
+        if args.atlas:
+            create_inventory_atlas(resources_dir, args.atlas)
+        return
+
     create_dsr_resources(resources_dir)
     create_ds3_resources(resources_dir)
     create_er_resources(resources_dir)
@@ -0,0 +1,423 @@
+"""Compare C++ and Python save parsers on the same files.
+
+Runs 'fssm-cli dump' and the Python parser over generated and fixture
+saves, compares character fields and inventories and prints speed ratio
+of both parsers per game.
+
+Example:
+    python compare_parsers.py --cli build/fssm-cli --gen build/fssm-gen-saves
+    python compare_parsers.py --cli build/fssm-cli --fixtures ~/saves
+
+Exit code is 1 if any mismatch was found.
+"""
+import argparse
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from collections import defaultdict
+from dataclasses import dataclass, field
+
+from from_soft_manager.parse import parse_sl2_file, parse_save_file
+from from_soft_manager.parse.structures import Game
+
+# Games with parser in both implementations
+SUPPORTED_GAMES = {
+    Game.DSR: "dsr",
+    Game.DS3: "ds3",
+    Game.ER: "er",
+}
+GENERATED_FILENAMES = {
+    "dsr": "DRAKS0005.sl2",
+    "ds3": "DS30000.sl2",
+    "er": "ER0000.sl2",
+}
+# Limit of reported mismatches per file, the rest is only counted
+MAX_REPORTED = 20
+# Known layout differences between parsers, reported but not failing
+#   unless '--strict' is used
+KNOWN_DIFFERENCES = {
+    "dsr": [
+        # Python reads 8 bytes at 212, C++ skips 4 bytes and reads 4 at 216
+        (re.compile(r"\.stats\.resistance$"), "resistance offset"),
+    ],
+}
+# Base ids of Estus and Ashen Estus flask, C++ shows empty flask as 0 amount
+DS3_FLASK_IDS = {1073741974, 1073742014}
+
+
+@dataclass
+class FileResult:
+    path: str
+    game: str
+    characters: int = 0
+    items: int = 0
+    cpp_ms: float = 0.0
+    python_ms: float = 0.0
+    mismatches: list[str] = field(default_factory=list)
+    mismatch_count: int = 0
+    known: dict[str, int] = field(default_factory=lambda: defaultdict(int))
+    error: str = ""
+
+    def add_mismatch(self, message: str, field_path: str = ""):
+        for pattern, reason in KNOWN_DIFFERENCES.get(self.game, []):
+            if field_path and pattern.search(field_path):
+                self.known[reason] += 1
+                return
+        self.mismatch_count += 1
+        if len(self.mismatches) < MAX_REPORTED:
+            self.mismatches.append(message)
+
+
+def _dsr_items(items):
+    return [
+        {
+            "item_id": item.item_id,
+            "item_type": item.item_type,
+            "amount": item.amount,
+            "upgrade_level": item.upgrade_level,
+            "infusion": item.infusion,
+            "durability": item.durability,
+            "order": item.order,
+        }
+        for item in items
+    ]
+
+
+def _ds3_amount(item) -> int:
+    if item.item_id in DS3_FLASK_IDS and item.amount == 1:
+        return 0
+    return item.amount
+
+
+def _ds3_items(items):
+    return [
+        {
+            "item_id": item.item_id,
+            "amount": _ds3_amount(item),
+            "upgrade_level": item.level,
+            # C++ exports index of 'Infusion' enum, python keeps id digits
+            "infusion": item.infusion // 100,
+        }
+        for item in items
+    ]
+
+
+def _dsr_character(char) -> dict:
+    return {
+        "index": char.index,
+        "name": char.name,
+        "level": char.level,
+        "souls": char.souls,
+        "humanity": char.humanity,
+        "hollow_state": char.hollow_state,
+        "covenant_id": char.covenant_id,
+        "covenant_levels": list(char.covenant_levels),
+        "class_id": char.class_id,
+        "gift_id": char.gift_id,
+        "physique_id": char.physique_id,
+        "gender": char.sex,
+        "hp": [char.hp_current, char.hp_max, char.hp_base],
+        "stamina": [char.stamina_current, char.stamina_max, char.stamina_base],
+        "stats": {
+            "vitality": char.vitality,
+            "attunement": char.attunement,
+            "endurance": char.endurance,
+            "strength": char.strength,
+            "dexterity": char.dexterity,
+            "resistance": char.resistance,
+            "intelligence": char.intelligence,
+            "faith": char.faith,
+        },
+        "inventory": _dsr_items(char.inventory_items),
+        "bottomless_box": _dsr_items(char.botomless_box_items),
+    }
+
+
+def _ds3_character(char) -> dict:
+    return {
+        "index": char.index,
+        "name": char.name,
+        "level": char.level,
+        "souls": char.souls,
+        "collected_souls": char.collected_souls,
+        "hollowing": char.hollowing,
+        "estus_max": char.estus_max,
+        "ashen_estus_max": char.ashen_estus_max,
+        "hp": [char.hp_current, char.hp_max, char.hp_base],
+        "fp": [char.fp_current, char.fp_max, char.fp_base],
+        "stamina": [char.stamina_current, char.stamina_max, char.stamina_base],
+        "stats": {
+            "vigor": char.vigor,
+            "attunement": char.attunement,
+            "endurance": char.endurance,
+            "vitality": char.vitality,
+            "strength": char.strength,
+            "dexterity": char.dexterity,
+            "intelligence": char.intelligence,
+            "faith": char.faith,
+            "luck": char.luck,
+        },
+        "inventory": _ds3_items(char.inventory_items),
+        "key_items": _ds3_items(char.key_items),
+        "storage_box": _ds3_items(char.storage_box_items),
+    }
+
+
+def _er_character(char) -> dict:
+    # Python parser does not read inventory of Elden Ring characters
+    return {
+        "index": char.index,
+        "name": char.name,
+        "version": char.ver,
+        "level": char.level,
+        "runes": char.runes,
+        "earned_runes": char.runes_memory,
+        "hp": [char.hp_current, char.hp_max, char.hp_base],
+        "fp": [char.fp_current, char.fp_max, char.fp_base],
+        "stamina": [char.stamina_current, char.stamina_max, char.stamina_base],
+        "stats": {
+            "vigor": char.vigor,
+            "mind": char.mind,
+            "endurance": char.endurance,
+            "strength": char.strength,
+            "dexterity": char.dexterity,
+            "intelligence": char.intelligence,
+            "faith": char.faith,
+            "arcane": char.arcane,
+        },
+    }
+
+
+CHARACTER_CONVERTORS = {
+    "dsr": _dsr_character,
+    "ds3": _ds3_character,
+    "er": _er_character,
+}
+
+
+def compare_values(result: FileResult, path: str, expected, value):
+    """Compare Python value (expected) with C++ value on keys of expected."""
+    if isinstance(expected, dict):
+        if not isinstance(value, dict):
+            result.add_mismatch(f"{path}: expected object, got {value!r}")
+            return
+        for key, sub_expected in expected.items():
+            if key not in value:
+                result.add_mismatch(f"{path}.{key}: missing in C++ output")
+                continue
+            compare_values(result, f"{path}.{key}", sub_expected, value[key])
+        return
+
+    if isinstance(expected, list):
+        if not isinstance(value, list):
+            result.add_mismatch(f"{path}: expected list, got {value!r}")
+            return
+        if len(expected) != len(value):
+            result.add_mismatch(
+                f"{path}: length {len(value)} != {len(expected)} (python)"
+            )
+        for idx, (sub_expected, sub_value) in enumerate(zip(expected, value)):
+            compare_values(result, f"{path}[{idx}]", sub_expected, sub_value)
+        return
+
+    if expected != value:
+        result.add_mismatch(
+            f"{path}: {value!r} != {expected!r} (python)", path
+        )
+
+
+def run_cpp(cli: str, path: str, repeat: int) -> tuple[dict, float]:
+    output = None
+    durations = []
+    for _ in range(repeat):
+        proc = subprocess.run(
+            [cli, "dump", path],
+            capture_output=True,
+            text=True,
+            encoding="utf-8",
+        )
+        lines = [line for line in proc.stdout.splitlines() if line.strip()]
+        if not lines:
+            raise RuntimeError(
+                f"fssm-cli returned no output (exit {proc.returncode}):"
+                f" {proc.stderr.strip()}"
+            )
+        output = json.loads(lines[0])
+        if "error" in output:
+            raise RuntimeError(f"fssm-cli failed: {output['error']}")
+        # Parse time without JSON export, comparable with 'parse_save_file'
+        durations.append(output["parse_ms"])
+    return output, min(durations)
+
+
+def run_python(path: str, repeat: int) -> tuple[object, float]:
+    output = None
+    durations = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        output = parse_save_file(path)
+        durations.append((time.perf_counter() - start) * 1000.0)
+    return output, min(durations)
+
+
+def compare_file(cli: str, path: str, repeat: int) -> FileResult:
+    try:
+        game = SUPPORTED_GAMES.get(parse_sl2_file(path).game)
+    except Exception as exc:
+        return FileResult(path, "unknown", error=f"python: {exc}")
+    result = FileResult(path, game or "unsupported")
+    if game is None:
+        result.error = "game is not supported by both parsers"
+        return result
+
+    try:
+        cpp_output, result.cpp_ms = run_cpp(cli, path, repeat)
+    except Exception as exc:
+        result.error = f"c++: {exc}"
+        return result
+    try:
+        py_output, result.python_ms = run_python(path, repeat)
+    except Exception as exc:
+        result.error = f"python: {exc}"
+        return result
+
+    convertor = CHARACTER_CONVERTORS[game]
+    cpp_chars = {char["index"]: char for char in cpp_output["characters"]}
+    # Python parses all slots, C++ only slots marked as occupied
+    py_chars = {
+        char.index: convertor(char)
+        for char in py_output.characters
+        if char is not None and char.index in cpp_chars
+    }
+    for index in sorted(cpp_chars):
+        cpp_char = cpp_chars[index]
+        py_char = py_chars.get(index)
+        if py_char is None:
+            result.add_mismatch(f"slot {index}: missing in python output")
+            continue
+        result.characters += 1
+        for key in ("inventory", "bottomless_box", "key_items", "storage_box"):
+            result.items += len(py_char.get(key, []))
+        compare_values(result, f"slot {index}", py_char, cpp_char)
+    return result
+
+
+def generate_saves(gen: str, work_dir: str, seeds: int) -> list[str]:
+    paths = []
+    for game, filename in GENERATED_FILENAMES.items():
+        for seed in range(1, seeds + 1):
+            path = os.path.join(work_dir, f"{game}_{seed}_{filename}")
+            subprocess.run(
+                [gen, "save", "--game", game, "--seed", str(seed),
+                 "--slots", "10", "-o", path],
+                check=True,
+                capture_output=True,
+            )
+            paths.append(path)
+    return paths
+
+
+def collect_fixtures(fixtures: list[str]) -> list[str]:
+    paths = []
+    for fixture in fixtures:
+        if os.path.isfile(fixture):
+            paths.append(fixture)
+            continue
+        for root, _, filenames in os.walk(fixture):
+            for filename in sorted(filenames):
+                if filename.lower().endswith(".sl2"):
+                    paths.append(os.path.join(root, filename))
+    return paths
+
+
+def print_report(results: list[FileResult]):
+    by_game = defaultdict(list)
+    for result in results:
+        status = "OK"
+        if result.error:
+            status = f"ERROR {result.error}"
+        elif result.mismatch_count:
+            status = f"{result.mismatch_count} mismatches"
+        print(f"{result.game:>4} {status:<20} {result.path}")
+        for reason, count in result.known.items():
+            print(f"       known difference '{reason}' x{count}")
+        for mismatch in result.mismatches:
+            print(f"       {mismatch}")
+        if result.mismatch_count > len(result.mismatches):
+            hidden = result.mismatch_count - len(result.mismatches)
+            print(f"       ... and {hidden} more")
+        if not result.error:
+            by_game[result.game].append(result)
+
+    print()
+    print(f"{'game':>4} {'files':>6} {'chars':>6} {'items':>7}"
+          f" {'c++ ms':>9} {'python ms':>10} {'py/c++':>7}")
+    for game, game_results in sorted(by_game.items()):
+        cpp_ms = statistics.median(r.cpp_ms for r in game_results)
+        python_ms = statistics.median(r.python_ms for r in game_results)
+        ratio = python_ms / cpp_ms if cpp_ms > 0 else 0.0
+        print(
+            f"{game:>4} {len(game_results):>6}"
+            f" {sum(r.characters for r in game_results):>6}"
+            f" {sum(r.items for r in game_results):>7}"
+            f" {cpp_ms:>9.2f} {python_ms:>10.2f} {ratio:>6.1f}x"
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare C++ and Python save parsers"
+    )
+    parser.add_argument("--cli", required=True, help="Path to fssm-cli")
+    parser.add_argument(
+        "--gen", help="Path to fssm-gen-saves, generated saves are skipped if not set"
+    )
+    parser.add_argument(
+        "--fixtures", nargs="*", default=[],
+        help="Save files or directories with .sl2 files"
+    )
+    parser.add_argument(
+        "--seeds", type=int, default=3,
+        help="Number of generated saves per game"
+    )
+    parser.add_argument(
+        "--repeat", type=int, default=3,
+        help="Parse each file N times, fastest run is used for speed ratio"
+    )
+    parser.add_argument(
+        "--work-dir", help="Directory for generated saves (default: temp directory)"
+    )
+    parser.add_argument(
+        "--strict", action="store_true",
+        help="Fail also on known differences between parsers"
+    )
+    args = parser.parse_args()
+
+    paths = collect_fixtures(args.fixtures)
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        work_dir = args.work_dir or tmp_dir
+        os.makedirs(work_dir, exist_ok=True)
+        if args.gen:
+            paths.extend(generate_saves(args.gen, work_dir, args.seeds))
+        if not paths:
+            parser.error("Nothing to compare, use --gen or --fixtures")
+
+        results = [
+            compare_file(args.cli, path, max(1, args.repeat))
+            for path in paths
+        ]
+    print_report(results)
+    failed = any(
+        r.error or r.mismatch_count or (args.strict and r.known)
+        for r in results
+    )
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,138 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+using json = nlohmann::json;
+
+namespace {
+std::atomic<uint64_t> g_sink = 0;
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * static_cast<double>(sorted.size())));
+    rank = std::clamp<size_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+struct Stats {
+    double min = 0.0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mbPerS = 0.0;
+    double itemsPerS = 0.0;
+};
+
+Stats computeStats(const fssm::bench::BenchResult& result) {
+    Stats stats;
+    if (result.samplesMs.empty()) return stats;
+    std::vector<double> sorted = result.samplesMs;
+    std::sort(sorted.begin(), sorted.end());
+    stats.min = sorted.front();
+    stats.max = sorted.back();
+    stats.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    stats.p50 = percentile(sorted, 50.0);
+    stats.p99 = percentile(sorted, 99.0);
+    // Throughput from median so single slow iterations do not skew comparison
+    if (stats.p50 > 0.0) {
+        stats.mbPerS = static_cast<double>(result.bytes) / (1024.0 * 1024.0) / (stats.p50 / 1000.0);
+        stats.itemsPerS = static_cast<double>(result.items) / (stats.p50 / 1000.0);
+    }
+    return stats;
+}
+}
+
+namespace fssm::bench {
+    void keep(uint64_t value) {
+        g_sink.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    bool BenchRunner::isEnabled(const std::string& name) const {
+        return m_config.filter.empty() || name.find(m_config.filter) != std::string::npos;
+    }
+
+    void BenchRunner::run(
+        const std::string& name,
+        uint64_t bytesPerIteration,
+        uint64_t itemsPerIteration,
+        const std::function<void()>& func,
+        const std::function<void()>& reset
+    ) {
+        if (!isEnabled(name)) return;
+        using Clock = std::chrono::steady_clock;
+        for (int i = 0; i < m_config.warmup; ++i) {
+            func();
+            if (reset) reset();
+        }
+
+        BenchResult result{name, {}, bytesPerIteration, itemsPerIteration, ""};
+        result.samplesMs.reserve(m_config.iterations);
+        for (int i = 0; i < m_config.iterations; ++i) {
+            Clock::time_point start = Clock::now();
+            func();
+            result.samplesMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            if (reset) reset();
+        }
+        Stats stats = computeStats(result);
+        std::cerr << std::left << std::setw(48) << name
+            << " p50 " << std::right << std::setw(10) << std::fixed << std::setprecision(3) << stats.p50 << " ms"
+            << " p99 " << std::setw(10) << stats.p99 << " ms\n";
+        m_results.push_back(std::move(result));
+    }
+
+    void BenchRunner::skip(const std::string& name, const std::string& reason) {
+        if (!isEnabled(name)) return;
+        std::cerr << std::left << std::setw(48) << name << " skipped: " << reason << "\n";
+        m_results.push_back(BenchResult{name, {}, 0, 0, reason});
+    }
+
+    json BenchRunner::toJson() const {
+        json results = json::array();
+        for (const auto& result: m_results) {
+            if (!result.skipReason.empty()) {
+                results.push_back({{"name", result.name}, {"skipped", result.skipReason}});
+                continue;
+            }
+            Stats stats = computeStats(result);
+            results.push_back({
+                {"name", result.name},
+                {"iterations", result.samplesMs.size()},
+                {"bytes", result.bytes},
+                {"items", result.items},
+                {"min_ms", stats.min},
+                {"mean_ms", stats.mean},
+                {"p50_ms", stats.p50},
+                {"p99_ms", stats.p99},
+                {"max_ms", stats.max},
+                {"mb_per_s", stats.mbPerS},
+                {"items_per_s", stats.itemsPerS},
+            });
+        }
+        return results;
+    }
+
+    void BenchRunner::printSummary(std::ostream& out) const {
+        out << std::left << std::setw(48) << "benchmark"
+            << std::right << std::setw(12) << "p50 ms"
+            << std::setw(12) << "p99 ms"
+            << std::setw(12) << "MB/s"
+            << std::setw(14) << "items/s" << "\n";
+        for (const auto& result: m_results) {
+            if (!result.skipReason.empty()) continue;
+            Stats stats = computeStats(result);
+            out << std::left << std::setw(48) << result.name << std::right << std::fixed
+                << std::setw(12) << std::setprecision(3) << stats.p50
+                << std::setw(12) << stats.p99
+                << std::setw(12) << std::setprecision(1) << stats.mbPerS
+                << std::setw(14) << std::setprecision(0) << stats.itemsPerS << "\n";
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace fssm::bench {
+    struct BenchConfig {
+        int iterations = 20;
+        int warmup = 2;
+        std::string filter;
+        std::string workDir;
+        std::vector<int> backupCounts = {10, 1000, 10000};
+    };
+
+    struct BenchResult {
+        std::string name;
+        // Duration of each timed iteration in milliseconds
+        std::vector<double> samplesMs;
+        // Bytes and items processed by one iteration, used for throughput
+        uint64_t bytes = 0;
+        uint64_t items = 0;
+        std::string skipReason;
+    };
+
+    // Runs benchmarks and collects per-iteration latency
+    class BenchRunner {
+    public:
+        explicit BenchRunner(const BenchConfig& config): m_config(config) {}
+        const BenchConfig& config() const { return m_config; }
+        bool isEnabled(const std::string& name) const;
+        // 'reset' is called after each iteration and is not timed
+        void run(
+            const std::string& name,
+            uint64_t bytesPerIteration,
+            uint64_t itemsPerIteration,
+            const std::function<void()>& func,
+            const std::function<void()>& reset = nullptr
+        );
+        void skip(const std::string& name, const std::string& reason);
+
+        nlohmann::json toJson() const;
+        void printSummary(std::ostream& out) const;
+    private:
+        BenchConfig m_config;
+        std::vector<BenchResult> m_results;
+    };
+
+    // Prevents compiler from removing benchmarked work
+    void keep(uint64_t value);
+
+    // Benchmarks using Qt models, available only if built with application sources
+    void runUiBenchmarks(BenchRunner& runner, const std::vector<std::string>& savePaths, int argc, char* argv[]);
+    bool hasUiBenchmarks();
+}
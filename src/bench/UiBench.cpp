@@ -0,0 +1,130 @@
+#include "Bench.h"
+
+#ifdef FSSM_BENCH_UI
+#include <QApplication>
+#include <filesystem>
+#include <optional>
+
+#include "generator/SaveGenerator.h"
+#include "ui/BackupsModel.h"
+#include "ui/DSRWidget/Inventory.h"
+#include "ui/DS3Widget/Inventory.h"
+
+namespace {
+std::optional<std::string> findSave(const std::vector<std::string>& savePaths, const fssm::Game& game) {
+    for (const auto& path: savePaths) {
+        if (fssm::parse::detect_sl2_game(path) == game) return path;
+    }
+    return std::nullopt;
+}
+
+void runBackupBenchmarks(fssm::bench::BenchRunner& runner, const std::string& savePath, int count) {
+    std::string suffix = "/" + std::to_string(count);
+    std::filesystem::path root = std::filesystem::path(runner.config().workDir) / ("backups_" + std::to_string(count));
+    // Backups are recreated so previous runs do not change the count
+    std::filesystem::remove_all(root);
+    fssm::generator::BackupsOptions options;
+    options.save.game = fssm::Game::DSR;
+    options.save.seed = 7;
+    options.count = count;
+    options.metadataOnly = true;
+    fssm::generator::generate_backups(root.string(), options);
+
+    BackupsModel model({}, ConfigAutobackup{}, QString::fromStdString(root.string()), nullptr);
+    QString qSavePath = QString::fromStdString(savePath);
+    // One backup with real save file to restore
+    std::optional<BackupMetadata> restoreItem = model.createBackup(qSavePath, fssm::Game::DSR, BackupType::MANUAL);
+    size_t found = model.getBackupItems(fssm::Game::DSR).size();
+    if (!restoreItem.has_value() || found != static_cast<size_t>(count) + 1) {
+        std::string reason = "Backup layout not readable on this platform";
+        runner.skip("BackupsModel::getBackupItems" + suffix, reason);
+        runner.skip("BackupsModel::createBackup" + suffix, reason);
+        runner.skip("BackupsModel::restoreBackupSave" + suffix, reason);
+        return;
+    }
+
+    runner.run("BackupsModel::getBackupItems" + suffix, 0, found, [&model]() {
+        fssm::bench::keep(model.getBackupItems(fssm::Game::DSR).size());
+    });
+
+    uint64_t saveSize = std::filesystem::file_size(savePath);
+    std::optional<BackupMetadata> created;
+    runner.run("BackupsModel::createBackup" + suffix, saveSize, 1, [&]() {
+        created = model.createBackup(qSavePath, fssm::Game::DSR, BackupType::QUICKSAVE);
+    }, [&created]() {
+        if (created.has_value()) std::filesystem::remove_all(created.value().backupDir);
+        created = std::nullopt;
+    });
+
+    std::filesystem::path restoreDir = std::filesystem::path(runner.config().workDir) / "restore";
+    std::filesystem::create_directories(restoreDir);
+    QString dstPath = QString::fromStdString((restoreDir / restoreItem.value().filenames[0]).string());
+    runner.run("BackupsModel::restoreBackupSave" + suffix, saveSize, 1, [&]() {
+        fssm::bench::keep(model.restoreBackupSave(dstPath, restoreItem.value()) ? 1 : 0);
+    });
+}
+
+void runInventoryBenchmarks(fssm::bench::BenchRunner& runner, const std::vector<std::string>& savePaths) {
+    if (auto path = findSave(savePaths, fssm::Game::DSR); path.has_value()) {
+        fssm::parse::dsr::DSRSaveFile saveFile = fssm::parse::dsr::parse_dsr_file(fssm::parse::parse_sl2_file(path.value()));
+        const fssm::parse::dsr::DSRCharacterInfo* charInfo = nullptr;
+        for (const auto& item: saveFile.characters) {
+            if (charInfo == nullptr || item.inventoryItems.size() > charInfo->inventoryItems.size()) charInfo = &item;
+        }
+        if (charInfo != nullptr) {
+            fssm::ui::dsr::InventoryModel model;
+            uint64_t items = charInfo->inventoryItems.size() + charInfo->bottomlessBoxItems.size();
+            runner.run("InventoryModel::setCharacter/dsr", 0, items, [&]() {
+                model.setCharacter(charInfo);
+                fssm::bench::keep(model.rowCount());
+            }, [&model]() { model.setCharacter(nullptr); });
+        }
+    }
+
+    if (auto path = findSave(savePaths, fssm::Game::DS3); path.has_value()) {
+        fssm::parse::ds3::DS3SaveFile saveFile = fssm::parse::ds3::parse_ds3_file(fssm::parse::parse_sl2_file(path.value()));
+        const fssm::parse::ds3::DS3CharacterInfo* charInfo = nullptr;
+        for (const auto& item: saveFile.characters) {
+            if (charInfo == nullptr || item.inventoryItems.size() > charInfo->inventoryItems.size()) charInfo = &item;
+        }
+        if (charInfo != nullptr) {
+            fssm::ui::ds3::InventoryModel model;
+            uint64_t items = charInfo->inventoryItems.size() + charInfo->storageBoxItems.size();
+            runner.run("InventoryModel::setCharacter/ds3", 0, items, [&]() {
+                model.setCharacter(charInfo);
+                fssm::bench::keep(model.rowCount());
+            }, [&model]() { model.setCharacter(nullptr); });
+        }
+    }
+}
+}
+
+namespace fssm::bench {
+    bool hasUiBenchmarks() { return true; }
+
+    void runUiBenchmarks(BenchRunner& runner, const std::vector<std::string>& savePaths, int argc, char* argv[]) {
+        // Models do not need visible windows
+        if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+        QApplication app(argc, argv);
+
+        std::optional<std::string> dsrSave = findSave(savePaths, fssm::Game::DSR);
+        for (int count: runner.config().backupCounts) {
+            if (!dsrSave.has_value()) {
+                runner.skip("BackupsModel/" + std::to_string(count), "DSR save is not available");
+                continue;
+            }
+            runBackupBenchmarks(runner, dsrSave.value(), count);
+        }
+        runInventoryBenchmarks(runner, savePaths);
+    }
+}
+
+#else
+
+namespace fssm::bench {
+    bool hasUiBenchmarks() { return false; }
+
+    void runUiBenchmarks(BenchRunner&, const std::vector<std::string>&, int, char*[]) {}
+}
+
+#endif
@@ -0,0 +1,299 @@
+#include <chrono>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Bench.h"
+#include "generator/SaveGenerator.h"
+#include "parse/Parse.h"
+#include "parse/Utils.h"
+#include "parse/DS3/Items.h"
+#include "parse/DSR/Items.h"
+
+using json = nlohmann::json;
+
+namespace {
+const char* USAGE = R"(Usage: fssm-bench [options]
+
+Options:
+  --saves FILE...      Use existing saves instead of generated ones (may be repeated)
+  --work-dir DIR       Directory for generated saves and backups (default: temp directory)
+  --iterations N       Timed iterations per benchmark (default: 20)
+  --warmup N           Untimed iterations per benchmark (default: 2)
+  --backups LIST       Comma separated backup counts (default: 10,1000,10000)
+  --filter TEXT        Run only benchmarks with TEXT in name
+  --out FILE           Write JSON report to FILE (default: stdout)
+  --quick              Shortcut for '--iterations 5 --backups 10,1000'
+
+JSON report contains p50/p99 latency and throughput of each benchmark,
+set FSSM_BENCH_LABEL environment variable to store e.g. commit hash in report.
+)";
+
+struct Options {
+    fssm::bench::BenchConfig bench;
+    std::vector<std::string> saves;
+    std::string outPath;
+};
+
+std::vector<int> parseCounts(const std::string& value) {
+    std::vector<int> output;
+    std::stringstream ss(value);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (!part.empty()) output.push_back(std::stoi(part));
+    }
+    return output;
+}
+
+std::optional<Options> parseArgs(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--saves" && hasValue) {
+            options.saves.push_back(argv[++i]);
+        } else if (arg == "--work-dir" && hasValue) {
+            options.bench.workDir = argv[++i];
+        } else if (arg == "--iterations" && hasValue) {
+            options.bench.iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.bench.warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--backups" && hasValue) {
+            options.bench.backupCounts = parseCounts(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            options.bench.filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.outPath = argv[++i];
+        } else if (arg == "--quick") {
+            options.bench.iterations = 5;
+            options.bench.backupCounts = {10, 1000};
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (options.bench.workDir.empty()) {
+        options.bench.workDir = (std::filesystem::temp_directory_path() / "fssm-bench").string();
+    }
+    return options;
+}
+
+std::string gameKey(fssm::Game game) {
+    std::string output = game.toString();
+    for (auto& c: output) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return output;
+}
+
+// Saves are generated with fixed seeds so results are comparable between runs
+std::vector<std::string> generateSaves(const std::string& workDir) {
+    std::filesystem::path savesDir = std::filesystem::path(workDir) / "saves";
+    std::filesystem::create_directories(savesDir);
+    std::vector<std::string> output;
+    for (fssm::Game game: {fssm::Game::DSR, fssm::Game::DS3, fssm::Game::ER}) {
+        std::filesystem::path path = savesDir / (gameKey(game) + "_" + fssm::generator::save_filename(game));
+        if (!std::filesystem::exists(path)) {
+            fssm::generator::SaveOptions options;
+            options.game = game;
+            options.seed = 42;
+            options.slots = 10;
+            fssm::parse::SL2File sl2 = fssm::generator::generate_save(options);
+            fssm::parse::write_sl2_file(sl2, path.string());
+        }
+        output.push_back(path.string());
+    }
+    return output;
+}
+
+uint64_t entriesSize(const fssm::parse::SL2File& sl2) {
+    uint64_t output = 0;
+    for (const auto& entry: sl2.entries) output += entry.content.size();
+    return output;
+}
+
+void runParseBenchmarks(fssm::bench::BenchRunner& runner, const std::string& path) {
+    fssm::Game game = fssm::parse::detect_sl2_game(path);
+    std::string key = gameKey(game);
+    uint64_t fileSize = std::filesystem::file_size(path);
+
+    fssm::parse::SL2File sl2 = fssm::parse::parse_sl2_file(path);
+    runner.run("parse_sl2_file/" + key, fileSize, sl2.entries.size(), [&path]() {
+        fssm::parse::SL2File output = fssm::parse::parse_sl2_file(path);
+        fssm::bench::keep(output.entries.size());
+    });
+
+    uint64_t contentSize = entriesSize(sl2);
+    switch (game) {
+        case fssm::Game::DSR: {
+            uint64_t items = 0;
+            for (const auto& charInfo: fssm::parse::dsr::parse_dsr_file(sl2).characters) {
+                items += charInfo.inventoryItems.size() + charInfo.bottomlessBoxItems.size();
+            }
+            runner.run("parse_dsr_file", contentSize, items, [&sl2]() {
+                fssm::bench::keep(fssm::parse::dsr::parse_dsr_file(sl2).characters.size());
+            });
+            break;
+        }
+        case fssm::Game::DS3: {
+            uint64_t items = 0;
+            for (const auto& charInfo: fssm::parse::ds3::parse_ds3_file(sl2).characters) {
+                items += charInfo.inventoryItems.size() + charInfo.keyItems.size() + charInfo.storageBoxItems.size();
+            }
+            runner.run("parse_ds3_file", contentSize, items, [&sl2]() {
+                fssm::bench::keep(fssm::parse::ds3::parse_ds3_file(sl2).characters.size());
+            });
+            break;
+        }
+        case fssm::Game::ER: {
+            uint64_t items = 0;
+            for (const auto& charInfo: fssm::parse::er::parse_er_file(sl2).characters) {
+                items += charInfo.inventoryItems.size() + charInfo.storageItems.size();
+            }
+            runner.run("parse_er_file", contentSize, items, [&sl2]() {
+                fssm::bench::keep(fssm::parse::er::parse_er_file(sl2).characters.size());
+            });
+            // Character list of the application reads only slot summaries
+            runner.run("parse_er_user_data/read", fileSize, 10, [&path]() {
+                fssm::parse::SL2File output = fssm::parse::parse_sl2_file(path, {10});
+                fssm::bench::keep(fssm::parse::er::parse_er_user_data(output).slotsSummary.occupied[0]);
+            });
+            // Opening a character parses only its slot entry
+            fssm::parse::er::UserData10 userData10 = fssm::parse::er::parse_er_user_data(sl2);
+            for (uint32_t idx = 0; idx < 10; ++idx) {
+                if (userData10.slotsSummary.occupied[idx] == 0) continue;
+                fssm::parse::er::ERCharacterInfo charInfo = fssm::parse::er::parse_er_character(sl2, static_cast<uint8_t>(idx));
+                const uint64_t charItems = charInfo.inventoryItems.size() + charInfo.storageItems.size();
+                runner.run("parse_er_character", sl2.entries[idx].content.size(), charItems, [&sl2, idx]() {
+                    fssm::bench::keep(fssm::parse::er::parse_er_character(sl2, static_cast<uint8_t>(idx)).level);
+                });
+                break;
+            }
+            break;
+        }
+        default:
+            runner.skip("parse/" + key, "Game is not supported");
+            break;
+    }
+}
+
+void runLookupBenchmarks(fssm::bench::BenchRunner& runner) {
+    // Known ids followed by the same amount of ids which are not in tables
+    std::vector<std::pair<uint32_t, uint32_t>> dsrKeys;
+    for (const auto& item: fssm::parse::dsr::ALL_ITEMS) {
+        dsrKeys.emplace_back(item.type, item.id);
+        dsrKeys.emplace_back(item.type, item.id + 7777777);
+    }
+    runner.run("findBaseItem/dsr", 0, dsrKeys.size(), [&dsrKeys]() {
+        uint64_t found = 0;
+        for (const auto& [type, id]: dsrKeys) {
+            found += fssm::parse::dsr::findBaseItem(type, id).has_value() ? 1 : 0;
+        }
+        fssm::bench::keep(found);
+    });
+
+    std::vector<uint32_t> ds3Keys;
+    for (const auto& item: fssm::parse::ds3::ALL_ITEMS) {
+        ds3Keys.push_back(item.id);
+        ds3Keys.push_back(item.id + 7777777);
+    }
+    runner.run("findBaseItem/ds3", 0, ds3Keys.size(), [&ds3Keys]() {
+        uint64_t found = 0;
+        for (uint32_t id: ds3Keys) {
+            found += fssm::parse::ds3::findBaseItem(id).has_value() ? 1 : 0;
+        }
+        fssm::bench::keep(found);
+    });
+}
+
+void runStringBenchmarks(fssm::bench::BenchRunner& runner) {
+    fssm::generator::Random rng(42);
+    std::vector<std::u16string> names;
+    uint64_t bytes = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::u16string name;
+        uint32_t length = rng.range(1, 16);
+        for (uint32_t c = 0; c < length; ++c) {
+            // Mostly ASCII with some accented and CJK characters
+            uint32_t roll = rng.range(0, 9);
+            if (roll < 7) name.push_back(static_cast<char16_t>(rng.range('a', 'z')));
+            else if (roll < 9) name.push_back(static_cast<char16_t>(rng.range(0xC0, 0x17F)));
+            else name.push_back(static_cast<char16_t>(rng.range(0x4E00, 0x9FFF)));
+        }
+        bytes += name.size() * 2;
+        names.push_back(std::move(name));
+    }
+    runner.run("utf16_to_utf8", bytes, names.size(), [&names]() {
+        uint64_t total = 0;
+        for (const auto& name: names) total += fssm::parse::utf16_to_utf8(name).size();
+        fssm::bench::keep(total);
+    });
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::optional<Options> optionsOpt;
+    try {
+        optionsOpt = parseArgs(argc, argv);
+    } catch (const std::exception&) {
+        optionsOpt = std::nullopt;
+    }
+    if (!optionsOpt.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+    Options& options = optionsOpt.value();
+    fssm::bench::BenchRunner runner(options.bench);
+
+    try {
+        std::vector<std::string> saves = options.saves;
+        if (saves.empty()) {
+            std::cerr << "Generating saves in " << options.bench.workDir << "\n";
+            saves = generateSaves(options.bench.workDir);
+        }
+        for (const auto& path: saves) {
+            runParseBenchmarks(runner, path);
+        }
+        runLookupBenchmarks(runner);
+        runStringBenchmarks(runner);
+        if (fssm::bench::hasUiBenchmarks()) {
+            fssm::bench::runUiBenchmarks(runner, saves, argc, argv);
+        } else {
+            runner.skip("ui", "Built without application sources (FSSM_BUILD_GUI=OFF)");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    const char* label = std::getenv("FSSM_BENCH_LABEL");
+    json report = {
+        {"label", label != nullptr ? label : ""},
+        {"timestamp", static_cast<int64_t>(std::time(nullptr))},
+#ifdef NDEBUG
+        {"optimized", true},
+#else
+        {"optimized", false},
+#endif
+        {"iterations", options.bench.iterations},
+        {"results", runner.toJson()},
+    };
+
+    runner.printSummary(std::cerr);
+    if (options.outPath.empty()) {
+        std::cout << report.dump(2) << "\n";
+    } else {
+        std::ofstream o(options.outPath);
+        o << report.dump(2) << std::endl;
+        if (!o) {
+            std::cerr << "Failed to write report " << options.outPath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include "Export.h"
+
+#include <string>
+
+#include "parse/Md5.h"
+#include "parse/Utils.h"
+
+using json = nlohmann::json;
+
+namespace {
+const char* erItemTypeToString(fssm::parse::er::ItemType itemType) {
+    switch (itemType) {
+        case fssm::parse::er::ItemType::Weapon: return "weapon";
+        case fssm::parse::er::ItemType::Armor: return "armor";
+        case fssm::parse::er::ItemType::Talisman: return "talisman";
+        case fssm::parse::er::ItemType::Goods: return "goods";
+        case fssm::parse::er::ItemType::AshOfWar: return "ash_of_war";
+        default: return "unknown";
+    }
+}
+
+json dsrItemsToJson(const std::vector<fssm::parse::dsr::InventoryItem>& items) {
+    json output = json::array();
+    for (const auto& item: items) {
+        output.push_back({
+            {"item_id", item.itemId},
+            {"item_type", item.itemType},
+            {"label", std::string(item.baseItem.label)},
+            {"known", item.knownItem},
+            {"amount", item.amount},
+            {"upgrade_level", item.upgradeLevel},
+            {"infusion", item.infusion},
+            {"durability", item.durability},
+            {"order", item.order},
+        });
+    }
+    return output;
+}
+
+json ds3ItemsToJson(const std::vector<fssm::parse::ds3::InventoryItem>& items) {
+    json output = json::array();
+    for (const auto& item: items) {
+        output.push_back({
+            {"item_id", item.itemId},
+            {"label", std::string(item.baseItem.label)},
+            {"amount", item.amount},
+            {"upgrade_level", item.upgradeLevel},
+            {"infusion", static_cast<int>(item.infusion)},
+        });
+    }
+    return output;
+}
+
+json erItemsToJson(const std::vector<fssm::parse::er::InventoryItem>& items) {
+    json output = json::array();
+    for (const auto& item: items) {
+        output.push_back({
+            {"item_id", item.itemId},
+            {"base_id", item.baseId()},
+            {"type", erItemTypeToString(item.type)},
+            {"amount", item.amount},
+            {"upgrade_level", item.upgradeLevel},
+            {"order", item.order},
+            {"key_item", item.isKeyItem},
+        });
+    }
+    return output;
+}
+}
+
+namespace fssm::cli {
+    json toJson(const parse::dsr::DSRCharacterInfo& charInfo, bool withInventory) {
+        json output = {
+            {"index", charInfo.index},
+            {"name", parse::utf16_to_utf8(charInfo.name)},
+            {"checksum", parse::to_hex(charInfo.checksum)},
+            {"level", charInfo.level},
+            {"souls", charInfo.souls},
+            {"earned_souls", charInfo.earnedSouls},
+            {"humanity", charInfo.humanity},
+            {"hollow_state", charInfo.hollowState},
+            {"covenant_id", charInfo.covenantId},
+            {"covenant_levels", charInfo.covenantLevels},
+            {"class_id", charInfo.classId},
+            {"gift_id", charInfo.giftId},
+            {"physique_id", charInfo.physiqueId},
+            {"gender", charInfo.gender},
+            {"hp", {charInfo.hpCurrent, charInfo.hpMax, charInfo.hpBase}},
+            {"stamina", {charInfo.staminaCurrent, charInfo.staminaMax, charInfo.staminaBase}},
+            {"stats", {
+                {"vitality", charInfo.vitality},
+                {"attunement", charInfo.attunement},
+                {"endurance", charInfo.endurance},
+                {"strength", charInfo.strength},
+                {"dexterity", charInfo.dexterity},
+                {"resistance", charInfo.resistance},
+                {"intelligence", charInfo.intelligence},
+                {"faith", charInfo.faith},
+            }},
+        };
+        if (withInventory) {
+            output["inventory"] = dsrItemsToJson(charInfo.inventoryItems);
+            output["bottomless_box"] = dsrItemsToJson(charInfo.bottomlessBoxItems);
+        }
+        return output;
+    }
+
+    json toJson(const parse::ds3::DS3CharacterInfo& charInfo, bool withInventory) {
+        json output = {
+            {"index", charInfo.index},
+            {"name", parse::utf16_to_utf8(charInfo.name)},
+            {"checksum", parse::to_hex(charInfo.checksum)},
+            {"level", charInfo.level},
+            {"souls", charInfo.souls},
+            {"collected_souls", charInfo.collectedSouls},
+            {"hollowing", charInfo.hollowing},
+            {"estus_max", charInfo.estusMax},
+            {"ashen_estus_max", charInfo.ashenEstusMax},
+            {"hp", {charInfo.hpCurrent, charInfo.hpMax, charInfo.hpBase}},
+            {"fp", {charInfo.fpCurrent, charInfo.fpMax, charInfo.fpBase}},
+            {"stamina", {charInfo.staminaCurrent, charInfo.staminaMax, charInfo.staminaBase}},
+            {"stats", {
+                {"vigor", charInfo.vigor},
+                {"attunement", charInfo.attunement},
+                {"endurance", charInfo.endurance},
+                {"vitality", charInfo.vitality},
+                {"strength", charInfo.strength},
+                {"dexterity", charInfo.dexterity},
+                {"intelligence", charInfo.intelligence},
+                {"faith", charInfo.faith},
+                {"luck", charInfo.luck},
+            }},
+        };
+        if (withInventory) {
+            output["inventory"] = ds3ItemsToJson(charInfo.inventoryItems);
+            output["key_items"] = ds3ItemsToJson(charInfo.keyItems);
+            output["storage_box"] = ds3ItemsToJson(charInfo.storageBoxItems);
+        }
+        return output;
+    }
+
+    json toJson(const parse::er::ERCharacterInfo& charInfo, bool withInventory) {
+        json output = {
+            {"index", charInfo.index},
+            {"name", parse::utf16_to_utf8(charInfo.name)},
+            {"checksum", parse::to_hex(charInfo.checksum)},
+            {"version", charInfo.version},
+            {"level", charInfo.level},
+            {"runes", charInfo.runes},
+            {"earned_runes", charInfo.earnedRunes},
+            {"hp", {charInfo.hpCurrent, charInfo.hpMax, charInfo.hpBase}},
+            {"fp", {charInfo.fpCurrent, charInfo.fpMax, charInfo.fpBase}},
+            {"stamina", {charInfo.staminaCurrent, charInfo.staminaMax, charInfo.staminaBase}},
+            {"stats", {
+                {"vigor", charInfo.vigor},
+                {"mind", charInfo.mind},
+                {"endurance", charInfo.endurance},
+                {"strength", charInfo.strength},
+                {"dexterity", charInfo.dexterity},
+                {"intelligence", charInfo.intelligence},
+                {"faith", charInfo.faith},
+                {"arcane", charInfo.arcane},
+            }},
+        };
+        if (withInventory) {
+            output["inventory"] = erItemsToJson(charInfo.inventoryItems);
+            output["storage"] = erItemsToJson(charInfo.storageItems);
+        }
+        return output;
+    }
+
+    json toJson(const parse::er::SlotSummary& summary) {
+        return {
+            {"index", summary.index},
+            {"name", parse::utf16_to_utf8(summary.name)},
+            {"level", summary.level},
+            {"checksum", parse::to_hex(summary.checksum)},
+        };
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <nlohmann/json.hpp>
+
+#include "parse/Parse.h"
+
+namespace fssm::cli {
+    // JSON representation of parsed characters, field names are stable for scripts
+    nlohmann::json toJson(const parse::dsr::DSRCharacterInfo& charInfo, bool withInventory);
+    nlohmann::json toJson(const parse::ds3::DS3CharacterInfo& charInfo, bool withInventory);
+    nlohmann::json toJson(const parse::er::ERCharacterInfo& charInfo, bool withInventory);
+    nlohmann::json toJson(const parse::er::SlotSummary& summary);
+}
@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Export.h"
+#include "parse/Md5.h"
+#include "parse/Parse.h"
+#include "parse/Trace.h"
+#include "parse/Utils.h"
+
+using json = nlohmann::json;
+
+namespace {
+const char* USAGE = R"(Usage: fssm-cli <command> [options] <path>...
+
+Commands:
+  probe <file>...      Detect game and list character slots
+  dump <file>...       Dump characters with stats and inventory
+  scan <dir>...        Probe and verify all .sl2 files under directories
+  verify <file>...     Verify MD5 checksums of container entries
+
+Options:
+  -j, --jobs N         Number of worker threads (default: hardware concurrency)
+  --slot N             dump: Only character in slot N (0-9)
+  --no-inventory       dump: Skip inventory items
+  --pretty             Indent output, one file per multiple lines
+
+Output is newline delimited JSON, one object per file in order of completion.
+Scan ends with a summary object. Exit code is 1 if any file failed.
+Set FSSM_TRACE={path} environment variable to write Chrome trace of parsing.
+)";
+
+struct Options {
+    std::string command;
+    std::vector<std::string> paths;
+    unsigned int jobs = 0;
+    std::optional<int> slot;
+    bool withInventory = true;
+    bool pretty = false;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Serializes whole lines so output of parallel workers is not interleaved
+class OutputStream {
+public:
+    explicit OutputStream(bool pretty): m_pretty(pretty) {}
+    void write(const json& value) {
+        std::string line = value.dump(m_pretty ? 2 : -1);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::cout << line << '\n';
+        std::cout.flush();
+    }
+private:
+    std::mutex m_mutex;
+    bool m_pretty;
+};
+
+// Damaged files are returned as result with error, exceptions are not used for them
+json errorJson(const std::string& path, const fssm::parse::ParseError& error) {
+    return {
+        {"path", path},
+        {"error", error.toString()},
+        {"error_code", fssm::parse::to_string(error.code)},
+        {"error_offset", error.offset},
+    };
+}
+
+json probeFile(const std::string& path) {
+    json output = {{"path", path}};
+    auto gameResult = fssm::parse::try_detect_sl2_game(path);
+    if (!gameResult) return errorJson(path, gameResult.error());
+    // ER needs only slot summaries, entries of other games are not loaded
+    fssm::Game game = gameResult.value();
+    auto sl2Result = (game == fssm::Game::DSR || game == fssm::Game::DS3)
+        ? fssm::parse::try_parse_sl2_file(path)
+        : fssm::parse::try_parse_sl2_file(path, game == fssm::Game::ER ? std::vector<uint32_t>{10} : std::vector<uint32_t>{});
+    if (!sl2Result) return errorJson(path, sl2Result.error());
+    const fssm::parse::SL2File& sl2 = sl2Result.value();
+
+    json slots = json::array();
+    switch (sl2.game) {
+        case fssm::Game::DSR: {
+            auto saveResult = fssm::parse::dsr::try_parse_dsr_file(sl2);
+            if (!saveResult) return errorJson(path, saveResult.error());
+            for (const auto& charInfo: saveResult.value().characters) {
+                slots.push_back({
+                    {"index", charInfo.index},
+                    {"name", fssm::parse::utf16_to_utf8(charInfo.name)},
+                    {"level", charInfo.level},
+                    {"checksum", fssm::parse::to_hex(charInfo.checksum)},
+                });
+            }
+            break;
+        }
+        case fssm::Game::DS3: {
+            auto saveResult = fssm::parse::ds3::try_parse_ds3_file(sl2);
+            if (!saveResult) return errorJson(path, saveResult.error());
+            for (const auto& charInfo: saveResult.value().characters) {
+                slots.push_back({
+                    {"index", charInfo.index},
+                    {"name", fssm::parse::utf16_to_utf8(charInfo.name)},
+                    {"level", charInfo.level},
+                    {"checksum", fssm::parse::to_hex(charInfo.checksum)},
+                });
+            }
+            break;
+        }
+        case fssm::Game::ER: {
+            auto userDataResult = fssm::parse::er::try_parse_er_user_data(sl2);
+            if (!userDataResult) return errorJson(path, userDataResult.error());
+            const fssm::parse::er::UserData10& userData10 = userDataResult.value();
+            for (int i = 0; i < 10; ++i) {
+                if (userData10.slotsSummary.occupied[i] == 0) continue;
+                slots.push_back(fssm::cli::toJson(userData10.slotsSummary.slots[i]));
+            }
+            break;
+        }
+        default:
+            slots = nullptr;
+            break;
+    }
+    output["game"] = sl2.game.toString();
+    output["entries"] = sl2.header.files_count;
+    output["slots"] = slots;
+    return output;
+}
+
+json dumpFile(const std::string& path, const Options& options) {
+    json output = {{"path", path}};
+    json characters = json::array();
+    auto acceptSlot = [&options](int index) {
+        return !options.slot.has_value() || options.slot.value() == index;
+    };
+    // Characters are parsed first and exported after, 'parse_ms' does not include JSON export
+    Clock::time_point parseStart = Clock::now();
+    auto gameResult = fssm::parse::try_detect_sl2_game(path);
+    if (!gameResult) return errorJson(path, gameResult.error());
+    fssm::Game game = gameResult.value();
+    switch (game) {
+        case fssm::Game::DSR: {
+            auto sl2Result = fssm::parse::try_parse_sl2_file(path);
+            if (!sl2Result) return errorJson(path, sl2Result.error());
+            auto saveResult = fssm::parse::dsr::try_parse_dsr_file(sl2Result.value());
+            if (!saveResult) return errorJson(path, saveResult.error());
+            output["parse_ms"] = elapsedMs(parseStart);
+            for (const auto& charInfo: saveResult.value().characters) {
+                if (acceptSlot(charInfo.index)) characters.push_back(fssm::cli::toJson(charInfo, options.withInventory));
+            }
+            break;
+        }
+        case fssm::Game::DS3: {
+            auto sl2Result = fssm::parse::try_parse_sl2_file(path);
+            if (!sl2Result) return errorJson(path, sl2Result.error());
+            auto saveResult = fssm::parse::ds3::try_parse_ds3_file(sl2Result.value());
+            if (!saveResult) return errorJson(path, saveResult.error());
+            output["parse_ms"] = elapsedMs(parseStart);
+            for (const auto& charInfo: saveResult.value().characters) {
+                if (acceptSlot(charInfo.index)) characters.push_back(fssm::cli::toJson(charInfo, options.withInventory));
+            }
+            break;
+        }
+        case fssm::Game::ER: {
+            // Decrypt only slot summaries and requested character entries
+            std::vector<uint32_t> entryIndexes = {10};
+            for (uint32_t i = 0; i < 10; ++i) {
+                if (acceptSlot(static_cast<int>(i))) entryIndexes.push_back(i);
+            }
+            auto sl2Result = fssm::parse::try_parse_sl2_file(path, entryIndexes);
+            if (!sl2Result) return errorJson(path, sl2Result.error());
+            const fssm::parse::SL2File& sl2 = sl2Result.value();
+            auto userDataResult = fssm::parse::er::try_parse_er_user_data(sl2);
+            if (!userDataResult) return errorJson(path, userDataResult.error());
+            const fssm::parse::er::UserData10& userData10 = userDataResult.value();
+            std::vector<fssm::parse::er::ERCharacterInfo> charInfos;
+            for (uint8_t i = 0; i < 10; ++i) {
+                if (userData10.slotsSummary.occupied[i] == 0 || !acceptSlot(i)) continue;
+                auto charResult = fssm::parse::er::try_parse_er_character(sl2, i);
+                if (!charResult) return errorJson(path, charResult.error());
+                charInfos.push_back(std::move(charResult).value());
+            }
+            output["parse_ms"] = elapsedMs(parseStart);
+            for (const auto& charInfo: charInfos) {
+                characters.push_back(fssm::cli::toJson(charInfo, options.withInventory));
+            }
+            break;
+        }
+        default:
+            return {{"path", path}, {"error", std::string("Dump is not supported for game ") + game.toString()}};
+    }
+    output["game"] = game.toString();
+    output["characters"] = characters;
+    return output;
+}
+
+json verifyFile(const std::string& path) {
+    json output = {{"path", path}};
+    auto checksumsResult = fssm::parse::try_verify_sl2_checksums(path);
+    if (!checksumsResult) return errorJson(path, checksumsResult.error());
+    json entries = json::array();
+    bool valid = true;
+    for (const auto& item: checksumsResult.value()) {
+        valid = valid && item.isValid();
+        entries.push_back({
+            {"index", item.index},
+            {"name", item.name},
+            {"valid", item.isValid()},
+            {"stored", fssm::parse::to_hex(item.stored)},
+            {"computed", fssm::parse::to_hex(item.computed)},
+        });
+    }
+    output["valid"] = valid;
+    output["entries"] = entries;
+    return output;
+}
+
+json scanFile(const std::string& path) {
+    json output = probeFile(path);
+    if (output.contains("error")) return output;
+    auto checksumsResult = fssm::parse::try_verify_sl2_checksums(path);
+    if (!checksumsResult) return errorJson(path, checksumsResult.error());
+    bool valid = true;
+    size_t invalidCount = 0;
+    for (const auto& item: checksumsResult.value()) {
+        if (item.isValid()) continue;
+        valid = false;
+        ++invalidCount;
+    }
+    output["valid"] = valid;
+    output["invalid_entries"] = invalidCount;
+    return output;
+}
+
+bool isSl2File(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".sl2";
+}
+
+std::vector<std::string> collectSaveFiles(const std::vector<std::string>& roots) {
+    std::vector<std::string> output;
+    for (const auto& root: roots) {
+        if (!std::filesystem::is_directory(root)) {
+            output.push_back(root);
+            continue;
+        }
+        auto dirOptions = std::filesystem::directory_options::skip_permission_denied;
+        for (const auto& dirEntry: std::filesystem::recursive_directory_iterator(root, dirOptions)) {
+            if (dirEntry.is_regular_file() && isSl2File(dirEntry.path())) {
+                output.push_back(dirEntry.path().string());
+            }
+        }
+    }
+    std::sort(output.begin(), output.end());
+    return output;
+}
+
+struct RunStats {
+    std::atomic<size_t> processed = 0;
+    std::atomic<size_t> failed = 0;
+    std::atomic<size_t> invalid = 0;
+};
+
+// Files are distributed to workers one by one, each result is written as soon as it is ready
+void runParallel(
+    const std::vector<std::string>& paths,
+    unsigned int jobs,
+    const std::function<json(const std::string&)>& func,
+    OutputStream& out,
+    RunStats& stats
+) {
+    std::atomic<size_t> nextIdx = 0;
+    auto worker = [&]() {
+        while (true) {
+            size_t idx = nextIdx.fetch_add(1);
+            if (idx >= paths.size()) break;
+            const std::string& path = paths[idx];
+            Clock::time_point start = Clock::now();
+            json result;
+            try {
+                result = func(path);
+                if (result.contains("error")) {
+                    ++stats.failed;
+                } else if (result.contains("valid") && !result["valid"].get<bool>()) {
+                    ++stats.invalid;
+                }
+            } catch (const fssm::parse::ParseException& e) {
+                // Last resort, parse errors are returned by 'try_*' functions
+                result = errorJson(path, e.error());
+                ++stats.failed;
+            } catch (const std::exception& e) {
+                result = {{"path", path}, {"error", e.what()}};
+                ++stats.failed;
+            }
+            result["elapsed_ms"] = elapsedMs(start);
+            ++stats.processed;
+            out.write(result);
+        }
+    };
+
+    unsigned int threadsCount = std::max(1u, std::min<unsigned int>(jobs, paths.size()));
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount - 1);
+    for (unsigned int i = 1; i < threadsCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread: threads) {
+        thread.join();
+    }
+}
+
+std::optional<Options> parseArgs(int argc, char* argv[]) {
+    if (argc < 2) return std::nullopt;
+    Options options;
+    options.command = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "--jobs") && i + 1 < argc) {
+            options.jobs = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (arg == "--slot" && i + 1 < argc) {
+            options.slot = std::stoi(argv[++i]);
+        } else if (arg == "--no-inventory") {
+            options.withInventory = false;
+        } else if (arg == "--pretty") {
+            options.pretty = true;
+        } else if (arg == "-h" || arg == "--help") {
+            return std::nullopt;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option '" << arg << "'\n";
+            return std::nullopt;
+        } else {
+            options.paths.push_back(arg);
+        }
+    }
+    if (options.paths.empty()) return std::nullopt;
+    if (options.jobs == 0) options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    return options;
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+    std::optional<Options> optionsOpt;
+    try {
+        optionsOpt = parseArgs(argc, argv);
+    } catch (const std::exception&) {
+        optionsOpt = std::nullopt;
+    }
+    if (!optionsOpt.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+    const Options& options = optionsOpt.value();
+
+    std::function<json(const std::string&)> func;
+    std::vector<std::string> paths = options.paths;
+    if (options.command == "probe") {
+        func = probeFile;
+    } else if (options.command == "dump") {
+        func = [&options](const std::string& path) { return dumpFile(path, options); };
+    } else if (options.command == "verify") {
+        func = verifyFile;
+    } else if (options.command == "scan") {
+        func = scanFile;
+        try {
+            paths = collectSaveFiles(options.paths);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to scan directory: " << e.what() << "\n";
+            return 1;
+        }
+    } else {
+        std::cerr << "Unknown command '" << options.command << "'\n" << USAGE;
+        return 2;
+    }
+
+    std::string tracePath = fssm::trace::init_from_environment();
+    OutputStream out(options.pretty);
+    RunStats stats;
+    Clock::time_point start = Clock::now();
+    runParallel(paths, options.jobs, func, out, stats);
+
+    if (options.command == "scan") {
+        out.write({{"summary", {
+            {"files", stats.processed.load()},
+            {"failed", stats.failed.load()},
+            {"invalid", stats.invalid.load()},
+            {"jobs", options.jobs},
+            {"elapsed_ms", elapsedMs(start)},
+        }}});
+    }
+    if (!tracePath.empty() && !fssm::trace::write_trace(tracePath)) {
+        std::cerr << "Failed to write trace " << tracePath << "\n";
+    }
+    return (stats.failed > 0 || stats.invalid > 0) ? 1 : 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "parse/SL2File.h"
+
+// Shared entry of fuzz targets
+// - damaged input is expected to be returned as error by 'try_*' functions, escaped exceptions,
+//   crashes and sanitizer reports are bugs
+namespace fssm::fuzz {
+    // Limit of entries read from plain input, real saves have at most 12
+    constexpr uint32_t MAX_PLAIN_ENTRIES = 64;
+
+    // Input is raw .sl2 content (use saves from 'fssm-gen-saves' as seed corpus)
+    // - used for container and Elden Ring, which does not encrypt entries
+    template <typename Func>
+    int runGameParser(const uint8_t* data, size_t size, Game game, Func parse) {
+        std::vector<uint8_t> content(data, data + size);
+        auto sl2Result = parse::try_parse_sl2_content(content);
+        if (!sl2Result) return 0;
+        // Mutations of other games are covered by their own targets
+        if (sl2Result.value().game != game) return 0;
+        parse(sl2Result.value());
+        return 0;
+    }
+
+    // Input is decrypted entry content, u32 entries count followed by u32 size and content of each entry
+    // - mutations of encrypted entries would decrypt to random blocks, so game parsers get plain content
+    // - use 'fssm-fuzz-seeds' to convert saves to this format
+    template <typename Func>
+    int runPlainGameParser(const uint8_t* data, size_t size, Game game, Func parse) {
+        auto readU32 = [&data, &size](uint32_t& value) {
+            if (size < 4) return false;
+            std::memcpy(&value, data, 4);
+            data += 4;
+            size -= 4;
+            return true;
+        };
+        uint32_t count;
+        if (!readU32(count) || count > MAX_PLAIN_ENTRIES) return 0;
+        parse::SL2File sl2;
+        sl2.game = game;
+        sl2.header.files_count = count;
+        sl2.entries.resize(count);
+        for (auto& entry: sl2.entries) {
+            uint32_t entrySize;
+            if (!readU32(entrySize) || entrySize > size) return 0;
+            entry.content.assign(data, data + entrySize);
+            data += entrySize;
+            size -= entrySize;
+        }
+        parse(sl2);
+        return 0;
+    }
+}
@@ -0,0 +1,9 @@
+#include "FuzzCommon.h"
+#include "parse/DS3/SaveFile.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    return fssm::fuzz::runPlainGameParser(data, size, fssm::Game::DS3, [](const fssm::parse::SL2File& sl2) {
+        // No offset cache is passed, result must depend only on the input
+        fssm::parse::ds3::try_parse_ds3_file(sl2);
+    });
+}
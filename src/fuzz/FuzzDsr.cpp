@@ -0,0 +1,8 @@
+#include "FuzzCommon.h"
+#include "parse/DSR/SaveFile.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    return fssm::fuzz::runPlainGameParser(data, size, fssm::Game::DSR, [](const fssm::parse::SL2File& sl2) {
+        fssm::parse::dsr::try_parse_dsr_file(sl2);
+    });
+}
@@ -0,0 +1,12 @@
+#include "FuzzCommon.h"
+#include "parse/EldenRing/SaveFile.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    return fssm::fuzz::runGameParser(data, size, fssm::Game::ER, [](const fssm::parse::SL2File& sl2) {
+        fssm::parse::er::try_parse_er_user_data(sl2);
+        // Parse also slots not marked as occupied, 'parse_er_file' would skip them
+        for (uint8_t idx = 0; idx < 10; ++idx) {
+            fssm::parse::er::try_parse_er_character(sl2, idx);
+        }
+    });
+}
@@ -0,0 +1,47 @@
+// Converts DSR and DS3 saves to plain input of 'fssm-fuzz-dsr' and 'fssm-fuzz-ds3' (see 'runPlainGameParser')
+// - other saves are skipped, raw saves are already seeds of other targets
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "parse/SL2File.h"
+
+namespace {
+void writeU32(std::ofstream& f, uint32_t value) {
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output directory> <save>...\n";
+        return 2;
+    }
+    std::filesystem::path outputDir(argv[1]);
+    std::filesystem::create_directories(outputDir);
+    int failed = 0;
+    for (int i = 2; i < argc; ++i) {
+        auto sl2Result = fssm::parse::try_parse_sl2_file(argv[i]);
+        if (!sl2Result) {
+            std::cerr << argv[i] << ": " << sl2Result.error().toString() << "\n";
+            ++failed;
+            continue;
+        }
+        const fssm::parse::SL2File& sl2 = sl2Result.value();
+        if (sl2.game != fssm::Game::DSR && sl2.game != fssm::Game::DS3) {
+            std::cerr << argv[i] << ": skipped " << sl2.game.toString() << " save\n";
+            continue;
+        }
+        std::string name = std::string(sl2.game.toString()) + "_" + std::filesystem::path(argv[i]).stem().string();
+        std::ofstream f(outputDir / name, std::ios::binary);
+        writeU32(f, static_cast<uint32_t>(sl2.entries.size()));
+        for (const auto& entry: sl2.entries) {
+            writeU32(f, static_cast<uint32_t>(entry.content.size()));
+            f.write(reinterpret_cast<const char*>(entry.content.data()), static_cast<std::streamsize>(entry.content.size()));
+        }
+        std::cerr << "Written " << (outputDir / name).string() << "\n";
+    }
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+// Replaces libFuzzer main when compiler does not support '-fsanitize=fuzzer' (e.g. GCC)
+// - runs the target once for each passed file or each file in passed directories
+// - useful to reproduce crashes and to run corpus with sanitizers
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+void runFile(const std::filesystem::path& path) {
+    std::ifstream f(path, std::ios::binary);
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    std::cerr << "Running " << path.string() << " (" << content.size() << " bytes)\n";
+    LLVMFuzzerTestOneInput(content.data(), content.size());
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file or directory>...\n";
+        return 2;
+    }
+    size_t count = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry: std::filesystem::recursive_directory_iterator(path)) {
+                if (!entry.is_regular_file()) continue;
+                runFile(entry.path());
+                ++count;
+            }
+        } else {
+            runFile(path);
+            ++count;
+        }
+    }
+    std::cerr << "Executed " << count << " inputs\n";
+    return 0;
+}
@@ -0,0 +1,724 @@
+#include "SaveGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include "parse/DS3/Items.h"
+#include "parse/DSR/Items.h"
+#include "parse/Utils.h"
+
+using json = nlohmann::json;
+
+namespace {
+// Sizes of decrypted entry data as stored by the games
+constexpr size_t DSR_ENTRY_SIZE = 0x60000;
+constexpr size_t DS3_SLOT_SIZE = 0xC0000;
+constexpr size_t DS3_MENU_SIZE = 0x60000;
+constexpr size_t DS3_SIDECAR_SIZE = 0x10000;
+constexpr size_t ER_SLOT_SIZE = 0x280000;
+constexpr size_t ER_USER_DATA_10_SIZE = 0x60000;
+constexpr size_t ER_USER_DATA_11_SIZE = 0x240000;
+
+constexpr uint32_t EMPTY_ID = 0xFFFFFFFFu;
+
+const char* NAME_PARTS[] = {
+    "Ash", "Bel", "Cor", "Dra", "El", "Fen", "Gal", "Hol", "Ir", "Jor",
+    "Kal", "Lor", "Mor", "Nel", "Or", "Pyr", "Quel", "Ros", "Sol", "Tor",
+    "Ul", "Vor", "Wyn", "Xan", "Yor", "Zel",
+};
+
+// Sequential writer mirroring 'ContentReader' so generated layout matches the parsers
+class ContentWriter {
+public:
+    explicit ContentWriter(size_t size): m_data(size, 0) {}
+    void u8(uint8_t v) { ensure(1); m_data[m_pos++] = v; }
+    void u16(uint16_t v) { ensure(2); fssm::parse::write_u16_le(m_data.data() + m_pos, v); m_pos += 2; }
+    void u32(uint32_t v) { ensure(4); fssm::parse::write_u32_le(m_data.data() + m_pos, v); m_pos += 4; }
+    void u64(uint64_t v) { ensure(8); fssm::parse::write_u64_le(m_data.data() + m_pos, v); m_pos += 8; }
+    void bytes(const uint8_t* src, size_t n) { ensure(n); std::memcpy(m_data.data() + m_pos, src, n); m_pos += n; }
+    void skip(size_t n) { ensure(n); m_pos += n; }
+    void seek(size_t pos) { m_pos = pos; ensure(0); }
+    // Fixed size UTF-16 string, 'units' includes space for terminator
+    void u16String(const std::string& s, size_t units) {
+        ensure(units * 2);
+        for (size_t i = 0; i < s.size() && i + 1 < units; ++i) {
+            fssm::parse::write_u16_le(m_data.data() + m_pos + i * 2, static_cast<uint8_t>(s[i]));
+        }
+        m_pos += units * 2;
+    }
+    size_t pos() const { return m_pos; }
+    std::vector<uint8_t> take() { return std::move(m_data); }
+private:
+    void ensure(size_t n) const {
+        if (m_pos + n > m_data.size()) throw std::out_of_range("write past end");
+    }
+    std::vector<uint8_t> m_data;
+    size_t m_pos = 0;
+};
+
+std::string randomName(fssm::generator::Random& rng, size_t maxLength) {
+    std::string name;
+    int parts = static_cast<int>(rng.range(1, 3));
+    for (int i = 0; i < parts; ++i) {
+        std::string part = NAME_PARTS[rng.range(0, std::size(NAME_PARTS) - 1)];
+        if (name.size() + part.size() > maxLength) break;
+        if (!name.empty()) std::transform(part.begin(), part.end(), part.begin(), ::tolower);
+        name += part;
+    }
+    return name;
+}
+
+int itemsCount(int requested, fssm::generator::Random& rng, uint32_t low, uint32_t high, size_t maxCount) {
+    size_t count = requested < 0 ? rng.range(low, high) : static_cast<size_t>(requested);
+    return static_cast<int>(std::min(count, maxCount));
+}
+
+fssm::parse::BND4Entry makeEntry(uint32_t index, std::vector<uint8_t> content) {
+    fssm::parse::BND4Entry entry{};
+    entry.header.padding = 0x50;
+    entry.header.entry_footer_length = 0xFFFFFFFFu;
+    char name[16];
+    std::snprintf(name, sizeof(name), "USER_DATA%03u", index);
+    entry.name = name;
+    entry.content = std::move(content);
+    return entry;
+}
+
+fssm::parse::SL2File makeContainer(fssm::Game game) {
+    fssm::parse::SL2File sl2;
+    sl2.game = game;
+    sl2.header.bnd_vers = {'B', 'N', 'D', '4'};
+    sl2.header.unknown_1 = 0x0001000000000000ull;
+    sl2.header.unknown_2 = 0x40;
+    std::memcpy(&sl2.header.sig, "00000001", 8);
+    sl2.header.unknown_3[0] = 0x20;
+    return sl2;
+}
+
+std::vector<uint32_t> occupiedSlots(const fssm::generator::SaveOptions& options, fssm::generator::Random& rng) {
+    int slots = std::clamp(options.slots, 1, 10);
+    std::vector<uint32_t> output;
+    // First slots are used most of the time, sometimes there are gaps
+    for (uint32_t idx = 0; idx < 10 && static_cast<int>(output.size()) < slots; ++idx) {
+        if (10 - idx > static_cast<uint32_t>(slots - output.size()) && rng.chance(15)) continue;
+        output.push_back(idx);
+    }
+    return output;
+}
+
+// --- Dark Souls Remastered ---
+std::vector<const fssm::parse::dsr::BaseItem*> dsrItemsPool(bool weaponsOnly) {
+    std::vector<const fssm::parse::dsr::BaseItem*> output;
+    for (const auto& item: fssm::parse::dsr::ALL_ITEMS) {
+        if (weaponsOnly && item.type != fssm::parse::dsr::TYPE_WEAPON) continue;
+        output.push_back(&item);
+    }
+    return output;
+}
+
+// Writes one 28 bytes record of inventory 'type, id, amount, order, ?, durability, ?'
+void writeDsrItem(ContentWriter& writer, fssm::generator::Random& rng, const fssm::parse::dsr::BaseItem& item, uint32_t order) {
+    uint32_t itemId = item.id;
+    // Weapons with upgrade level in last two digits of id
+    if (
+        item.type == fssm::parse::dsr::TYPE_WEAPON
+        && item.id % 100 == 0
+        && item.category == fssm::parse::dsr::ItemCategory::WeaponsShields
+    ) {
+        uint32_t level = rng.range(0, 15);
+        if (level == 0 || !fssm::parse::dsr::findBaseItem(item.type, item.id + level).has_value()) {
+            itemId += level;
+        }
+    }
+    writer.u32(item.type);
+    writer.u32(itemId);
+    writer.u32(rng.range(1, std::max<uint32_t>(1, std::min<uint32_t>(item.max_stack_count, 99))));
+    writer.u32(order);
+    writer.u32(1);
+    writer.u32(rng.range(0, 500));
+    writer.u32(0);
+}
+
+std::vector<uint8_t> buildDsrSlot(fssm::generator::Random& rng, const fssm::generator::SaveOptions& options, const std::string& name) {
+    static const std::vector<const fssm::parse::dsr::BaseItem*> allItems = dsrItemsPool(false);
+    static const std::vector<const fssm::parse::dsr::BaseItem*> weapons = dsrItemsPool(true);
+    constexpr uint32_t maxInventoryCount = 2048;
+
+    ContentWriter writer(DSR_ENTRY_SIZE);
+    std::array<uint32_t, 8> stats;
+    for (auto& stat: stats) stat = rng.range(8, 50);
+    uint32_t level = 0;
+    for (auto stat: stats) level += stat;
+
+    // Non-zero header of used slot
+    writer.u32(0x47);
+    writer.skip(92);
+    uint32_t hp = rng.range(400, 1900);
+    writer.u32(hp); writer.u32(hp); writer.u32(hp);
+    writer.skip(16);
+    uint32_t stamina = rng.range(80, 160);
+    writer.u32(stamina); writer.u32(stamina); writer.u32(stamina);
+    for (int i = 0; i < 7; ++i) {
+        writer.skip(4);
+        writer.u32(stats[i]);
+    }
+    writer.skip(16);
+    writer.u32(rng.range(0, 99));  // humanity
+    writer.skip(4);
+    writer.u32(stats[7]);  // resistance
+    writer.u32(level > 80 ? level - 80 : 1);
+    writer.u32(rng.range(0, 200000));
+    writer.skip(4);
+    writer.u32(rng.range(0, 5000000));
+    writer.skip(4);
+    writer.u32(rng.range(0, 1));  // hollow state
+    writer.u16String(name, 12);
+    writer.skip(10);
+    writer.u32(rng.range(0, 1));  // gender
+    writer.u8(static_cast<uint8_t>(rng.range(0, 9)));  // class
+    writer.u8(static_cast<uint8_t>(rng.range(0, 8)));  // physique
+    writer.u8(static_cast<uint8_t>(rng.range(0, 8)));  // gift
+    writer.skip(3);
+    writer.u32(rng.range(0, 100));
+    writer.u32(rng.range(0, 100));
+    writer.skip(14);
+    for (int i = 0; i < 10; ++i) writer.u8(static_cast<uint8_t>(rng.range(0, 3)));
+    writer.skip(12);
+    for (int i = 0; i < 4; ++i) writer.u32(rng.range(0, 400));
+    writer.skip(3);
+    writer.u8(static_cast<uint8_t>(rng.range(0, 9)));  // covenant
+    for (int i = 0; i < 4; ++i) writer.u8(static_cast<uint8_t>(rng.range(0, 10)));
+    writer.skip(412);
+    // Equipment slots are indexes to inventory
+    for (int i = 0; i < 12; ++i) writer.u32(rng.range(0, 30));
+    writer.skip(4);
+    for (int i = 0; i < 7; ++i) writer.u32(rng.range(0, 30));
+
+    int inventoryCount = itemsCount(options.inventoryItems, rng, 80, 350, maxInventoryCount);
+    writer.u32(static_cast<uint32_t>(inventoryCount));
+    writer.u32(0);
+    writer.u32(maxInventoryCount);
+    for (uint32_t idx = 0; idx < maxInventoryCount; ++idx) {
+        if (idx < static_cast<uint32_t>(inventoryCount)) {
+            writeDsrItem(writer, rng, *allItems[rng.range(0, allItems.size() - 1)], idx);
+        } else {
+            writer.u32(EMPTY_ID);
+            writer.u32(EMPTY_ID);
+            writer.skip(20);
+        }
+    }
+    writer.skip(4);
+    for (int i = 0; i < 12; ++i) {
+        writer.u32(rng.chance(30) ? rng.range(3000, 5500) : EMPTY_ID);
+        writer.u32(rng.range(0, 30));
+    }
+    writer.skip(28);
+    for (int i = 0; i < 18; ++i) writer.u16(static_cast<uint16_t>(rng.range(0, 1)));
+    writer.skip(136);
+
+    // Bottomless box derives item type from id, plain weapon ids are used
+    int boxCount = itemsCount(options.storageItems, rng, 0, 150, maxInventoryCount);
+    for (uint32_t idx = 0; idx < maxInventoryCount; ++idx) {
+        if (idx < static_cast<uint32_t>(boxCount)) {
+            const auto& item = *weapons[rng.range(0, weapons.size() - 1)];
+            writer.skip(8);
+            writer.u32(item.id);
+            writer.u32(idx);
+            writer.u16(1);
+            writer.skip(2);
+            writer.u32(rng.range(0, 500));
+            writer.skip(8);
+        } else {
+            writer.skip(8);
+            writer.u32(EMPTY_ID);
+            writer.skip(20);
+        }
+    }
+    return writer.take();
+}
+
+fssm::parse::SL2File generateDsr(const fssm::generator::SaveOptions& options) {
+    fssm::generator::Random rng(options.seed);
+    fssm::parse::SL2File sl2 = makeContainer(fssm::Game::DSR);
+    std::vector<uint32_t> occupied = occupiedSlots(options, rng);
+    ContentWriter sideWriter(DSR_ENTRY_SIZE);
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        bool isOccupied = std::find(occupied.begin(), occupied.end(), idx) != occupied.end();
+        std::vector<uint8_t> content;
+        if (isOccupied) {
+            content = buildDsrSlot(rng, options, randomName(rng, 11));
+        } else {
+            content.resize(DSR_ENTRY_SIZE, 0);
+        }
+        sideWriter.seek(176 + idx);
+        sideWriter.u8(isOccupied ? 1 : 0);
+        sl2.entries.push_back(makeEntry(idx, std::move(content)));
+    }
+    sl2.entries.push_back(makeEntry(10, sideWriter.take()));
+    return sl2;
+}
+
+// --- Dark Souls III ---
+bool ds3IsRoundTrip(const fssm::parse::ds3::BaseItem& item) {
+    // Ids in weapon range encode upgrade and infusion in last digits
+    if (1000000 < item.id && item.id <= 23020000 && item.id % 10000 != 0) return false;
+    switch (item.id) {
+        case 110000:
+        case 269335456:
+        case 269336456:
+        case 269337456:
+        case 269338456:
+            return false;
+        default:
+            return true;
+    }
+}
+
+std::vector<const fssm::parse::ds3::BaseItem*> ds3ItemsPool(bool keyItems) {
+    std::vector<const fssm::parse::ds3::BaseItem*> output;
+    for (const auto& item: fssm::parse::ds3::ALL_ITEMS) {
+        if (!ds3IsRoundTrip(item)) continue;
+        if ((item.category == fssm::parse::ds3::ItemCategory::KeyItems) != keyItems) continue;
+        output.push_back(&item);
+    }
+    return output;
+}
+
+// Writes one 16 bytes record 'handle, id, amount, ?'
+void writeDs3Item(ContentWriter& writer, fssm::generator::Random& rng, const fssm::parse::ds3::BaseItem& item, uint32_t handle) {
+    uint32_t itemId = item.id;
+    uint32_t amount = rng.range(1, std::max<uint32_t>(1, std::min<uint32_t>(item.max_inventory, 99)));
+    if (1000000 < itemId && itemId <= 23020000) {
+        if (!item.infusion_label.empty()) itemId += rng.range(0, 15) * 100;
+        itemId += rng.range(0, 10);
+        amount = 1;
+    }
+    writer.u32(handle);
+    writer.u32(itemId);
+    writer.u32(amount);
+    writer.u32(0);
+}
+
+void writeDs3Items(
+    ContentWriter& writer,
+    fssm::generator::Random& rng,
+    const std::vector<const fssm::parse::ds3::BaseItem*>& pool,
+    size_t capacity,
+    int count
+) {
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        if (idx < static_cast<size_t>(count) && !pool.empty()) {
+            writeDs3Item(writer, rng, *pool[rng.range(0, pool.size() - 1)], 0x80000000u | static_cast<uint32_t>(idx));
+        } else {
+            writer.u32(0);
+            writer.u32(EMPTY_ID);
+            writer.u32(0);
+            writer.u32(0);
+        }
+    }
+}
+
+std::vector<uint8_t> buildDs3Slot(fssm::generator::Random& rng, const fssm::generator::SaveOptions& options, uint32_t& charLevel) {
+    static const std::vector<const fssm::parse::ds3::BaseItem*> items = ds3ItemsPool(false);
+    static const std::vector<const fssm::parse::ds3::BaseItem*> keyItems = ds3ItemsPool(true);
+
+    ContentWriter writer(DS3_SLOT_SIZE);
+    writer.seek(108);
+    // Variable length records before character stats, 8 bytes if empty, 60 bytes otherwise
+    for (int i = 0; i < 6144; ++i) {
+        if (rng.chance(10)) {
+            writer.u32(rng.range(1, 0x7fffffff));
+            writer.u32(rng.range(1, 1000));
+            writer.skip(52);
+        } else {
+            writer.u32(0);
+            writer.u32(EMPTY_ID);
+        }
+    }
+    writer.skip(8);
+    uint32_t hp = rng.range(400, 2000);
+    uint32_t fp = rng.range(80, 300);
+    uint32_t stamina = rng.range(90, 170);
+    writer.u32(hp); writer.u32(hp); writer.u32(hp);
+    writer.u32(fp); writer.u32(fp); writer.u32(fp);
+    writer.skip(4);
+    writer.u32(stamina); writer.u32(stamina); writer.u32(stamina);
+    writer.skip(4);
+    std::array<uint32_t, 9> stats;
+    for (auto& stat: stats) stat = rng.range(8, 60);
+    uint32_t level = 0;
+    for (auto stat: stats) level += stat;
+    for (int i = 0; i < 8; ++i) writer.u32(stats[i]);
+    writer.skip(8);
+    writer.u32(stats[8]);  // vitality
+    charLevel = level > 89 ? level - 89 : 1;
+    writer.u32(charLevel);
+    writer.u32(rng.range(0, 300000));
+    writer.u32(rng.range(0, 9000000));
+    writer.skip(100);
+    for (int i = 0; i < 5; ++i) writer.u32(rng.range(80, 300));
+    writer.skip(10);
+    writer.u8(static_cast<uint8_t>(rng.range(0, 15)));  // hollowing
+    writer.skip(3);
+    writer.u8(static_cast<uint8_t>(rng.range(3, 15)));
+    writer.u8(static_cast<uint8_t>(rng.range(0, 12)));
+    writer.skip(548);
+
+    int inventoryCount = itemsCount(options.inventoryItems, rng, 100, 450, 1920);
+    writer.u32(static_cast<uint32_t>(inventoryCount));
+    writeDs3Items(writer, rng, items, 1920, inventoryCount);
+    writer.skip(4);
+    writeDs3Items(writer, rng, keyItems, 128, static_cast<int>(rng.range(5, 40)));
+    writer.skip(2304);
+    for (int i = 0; i < 7; ++i) writer.u8(static_cast<uint8_t>(rng.range(0, 1)));
+    writer.skip(25);
+    uint32_t toolsCount = rng.range(0, 10);
+    writer.u32(toolsCount);
+    for (uint32_t i = 0; i < toolsCount; ++i) {
+        writer.u32(items[rng.range(0, items.size() - 1)]->id);
+        writer.skip(4);
+    }
+    writer.skip(400);
+    writeDs3Items(writer, rng, items, 1920, itemsCount(options.storageItems, rng, 0, 200, 1920));
+    return writer.take();
+}
+
+fssm::parse::SL2File generateDs3(const fssm::generator::SaveOptions& options) {
+    fssm::generator::Random rng(options.seed);
+    fssm::parse::SL2File sl2 = makeContainer(fssm::Game::DS3);
+    std::vector<uint32_t> occupied = occupiedSlots(options, rng);
+    ContentWriter menuWriter(DS3_MENU_SIZE);
+    menuWriter.seek(4);
+    menuWriter.u64(76561190000000000ull + rng.range(0, 0x7fffffff));
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        bool isOccupied = std::find(occupied.begin(), occupied.end(), idx) != occupied.end();
+        std::vector<uint8_t> content;
+        if (isOccupied) {
+            uint32_t charLevel = 1;
+            content = buildDs3Slot(rng, options, charLevel);
+            menuWriter.seek(4254 + 554 * idx);
+            menuWriter.u16String(randomName(rng, 15), 16);
+            // Menu summary repeats level of the character
+            menuWriter.seek(4254 + 554 * idx + 34);
+            menuWriter.u32(charLevel);
+        } else {
+            content.resize(DS3_SLOT_SIZE, 0);
+        }
+        menuWriter.seek(4244 + idx);
+        menuWriter.u8(isOccupied ? 1 : 0);
+        sl2.entries.push_back(makeEntry(idx, std::move(content)));
+    }
+    sl2.entries.push_back(makeEntry(10, menuWriter.take()));
+    sl2.entries.push_back(makeEntry(11, std::vector<uint8_t>(DS3_SIDECAR_SIZE, 0)));
+    return sl2;
+}
+
+// --- Elden Ring ---
+struct ERItemRef {
+    uint32_t handle;
+    uint32_t itemId;
+};
+
+uint32_t erRandomWeaponId(fssm::generator::Random& rng) {
+    return rng.range(1, 67) * 1000000 + rng.range(0, 9) * 10000 + rng.range(0, 25);
+}
+
+uint32_t erRandomArmorId(fssm::generator::Random& rng) {
+    return 0x10000000u | (rng.range(40, 2100) * 1000 + rng.range(0, 3) * 100);
+}
+
+// Records of inventory 'handle, amount, acquisition index'
+void writeErItems(
+    ContentWriter& writer,
+    fssm::generator::Random& rng,
+    const std::vector<ERItemRef>& gaItems,
+    size_t capacity,
+    int count,
+    uint32_t& order
+) {
+    writer.u32(static_cast<uint32_t>(count));
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        if (idx >= static_cast<size_t>(count)) {
+            writer.u32(0);
+            writer.u32(0);
+            writer.u32(0);
+            continue;
+        }
+        uint32_t handle;
+        uint32_t amount = 1;
+        uint32_t kind = rng.range(0, 9);
+        if (kind < 4 && !gaItems.empty()) {
+            handle = gaItems[rng.range(0, gaItems.size() - 1)].handle;
+        } else if (kind < 5) {
+            handle = 0xA0000000u | (1000 + rng.range(0, 170) * 10);
+        } else {
+            handle = 0xB0000000u | rng.range(100, 9000);
+            amount = rng.range(1, 99);
+        }
+        writer.u32(handle);
+        writer.u32(amount);
+        writer.u32(order++);
+    }
+}
+
+std::vector<uint8_t> buildErSlot(
+    fssm::generator::Random& rng,
+    const fssm::generator::SaveOptions& options,
+    const std::string& name,
+    uint32_t level
+) {
+    ContentWriter writer(ER_SLOT_SIZE);
+    writer.u32(215);  // version, newer saves have 5120 gaitems
+    writer.u32(rng.range(0x0A000000, 0x3CFFFFFF));
+    writer.skip(8);
+    writer.skip(16);
+
+    // Weapons, armors and ashes of war are stored in gaitem table, handles are referenced by inventory
+    std::vector<ERItemRef> gaItems;
+    uint32_t gaItemsCount = rng.range(300, 1500);
+    for (uint32_t idx = 0; idx < 5120; ++idx) {
+        if (idx >= gaItemsCount) {
+            writer.u32(0);
+            writer.u32(0);
+            continue;
+        }
+        uint32_t kind = rng.range(0, 9);
+        if (kind < 5) {
+            uint32_t handle = 0x80800000u | idx;
+            uint32_t itemId = erRandomWeaponId(rng);
+            writer.u32(handle);
+            writer.u32(itemId);
+            writer.u32(EMPTY_ID);
+            writer.u32(EMPTY_ID);
+            writer.u32(EMPTY_ID);
+            writer.u8(0);
+            gaItems.push_back({handle, itemId});
+        } else if (kind < 9) {
+            uint32_t handle = 0x90800000u | idx;
+            uint32_t itemId = erRandomArmorId(rng);
+            writer.u32(handle);
+            writer.u32(itemId);
+            writer.u32(EMPTY_ID);
+            writer.u32(EMPTY_ID);
+            gaItems.push_back({handle, itemId});
+        } else {
+            uint32_t handle = 0xC0800000u | idx;
+            uint32_t itemId = 0x80000000u | (10000 + rng.range(0, 120) * 100);
+            writer.u32(handle);
+            writer.u32(itemId);
+            gaItems.push_back({handle, itemId});
+        }
+    }
+
+    writer.skip(8);
+    uint32_t hp = rng.range(400, 2100);
+    uint32_t fp = rng.range(60, 450);
+    uint32_t stamina = rng.range(80, 170);
+    writer.u32(hp); writer.u32(hp); writer.u32(hp);
+    writer.u32(fp); writer.u32(fp); writer.u32(fp);
+    writer.skip(4);
+    writer.u32(stamina); writer.u32(stamina); writer.u32(stamina);
+    writer.skip(4);
+    for (int i = 0; i < 8; ++i) writer.u32(rng.range(8, 60));
+    writer.skip(12);
+    writer.u32(level);
+    writer.u32(rng.range(0, 500000));
+    writer.u32(rng.range(0, 50000000));
+    writer.skip(40);
+    writer.u16String(name, 16);
+    writer.skip(252);
+    writer.skip(208);
+    writer.skip(88 + 28 + 88 + 88);
+
+    uint32_t order = 1;
+    writeErItems(writer, rng, gaItems, 2688, itemsCount(options.inventoryItems, rng, 300, 900, 2688), order);
+    writeErItems(writer, rng, {}, 384, static_cast<int>(rng.range(20, 120)), order);
+    writer.skip(8);
+
+    writer.skip(116 + 140 + 24);
+    uint32_t projectilesCount = rng.range(0, 8);
+    writer.u32(projectilesCount);
+    writer.skip(8 * projectilesCount);
+    writer.skip(156 + 12 + 303);
+
+    writeErItems(writer, rng, gaItems, 1920, itemsCount(options.storageItems, rng, 50, 600, 1920), order);
+    writeErItems(writer, rng, {}, 128, 0, order);
+    writer.skip(8);
+    return writer.take();
+}
+
+void writeErSlotSummary(ContentWriter& writer, fssm::generator::Random& rng, const std::string& name, uint32_t level) {
+    writer.u16String(name, 17);
+    writer.u32(level);
+    for (int i = 0; i < 5; ++i) writer.u32(rng.range(0, 1000));
+    writer.skip(288);
+    // Equipment gaitem handles and item ids
+    for (int i = 0; i < 30; ++i) writer.u32(rng.chance(50) ? EMPTY_ID : rng.range(0, 0x7fffffff));
+    for (int i = 0; i < 27; ++i) writer.u32(rng.chance(50) ? EMPTY_ID : rng.range(0, 0x7fffffff));
+    for (int i = 0; i < 6; ++i) writer.u8(static_cast<uint8_t>(rng.range(0, 255)));
+    writer.u32(0);
+}
+
+fssm::parse::SL2File generateEr(const fssm::generator::SaveOptions& options) {
+    fssm::generator::Random rng(options.seed);
+    fssm::parse::SL2File sl2 = makeContainer(fssm::Game::ER);
+    std::vector<uint32_t> occupied = occupiedSlots(options, rng);
+
+    std::array<std::string, 10> names;
+    std::array<uint32_t, 10> levels{};
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        bool isOccupied = std::find(occupied.begin(), occupied.end(), idx) != occupied.end();
+        std::vector<uint8_t> content;
+        if (isOccupied) {
+            names[idx] = randomName(rng, 15);
+            levels[idx] = rng.range(1, 713);
+            content = buildErSlot(rng, options, names[idx], levels[idx]);
+        } else {
+            content.resize(ER_SLOT_SIZE, 0);
+        }
+        sl2.entries.push_back(makeEntry(idx, std::move(content)));
+    }
+
+    ContentWriter writer(ER_USER_DATA_10_SIZE);
+    writer.u32(215);
+    writer.u64(76561190000000000ull + rng.range(0, 0x7fffffff));
+    writer.skip(320);
+    writer.u16(0);
+    writer.u16(0);
+    constexpr uint32_t menuSystemLength = 0x1008;
+    writer.u32(menuSystemLength);
+    writer.skip(menuSystemLength);
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        writer.u8(names[idx].empty() ? 0 : 1);
+    }
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        writeErSlotSummary(writer, rng, names[idx], levels[idx]);
+    }
+    sl2.entries.push_back(makeEntry(10, writer.take()));
+    sl2.entries.push_back(makeEntry(11, std::vector<uint8_t>(ER_USER_DATA_11_SIZE, 0)));
+    return sl2;
+}
+
+// --- Backups ---
+std::string randomId(fssm::generator::Random& rng) {
+    static constexpr char HEX_CHARS[] = "0123456789abcdef";
+    std::string output;
+    output.reserve(32);
+    for (int i = 0; i < 32; ++i) output.push_back(HEX_CHARS[rng.range(0, 15)]);
+    // Version 4 UUID markers
+    output[12] = '4';
+    output[16] = HEX_CHARS[8 + rng.range(0, 3)];
+    return output;
+}
+
+std::string formatTime(int64_t epoch, const char* format) {
+    std::time_t value = static_cast<std::time_t>(epoch);
+    std::tm tmValue{};
+#ifdef _WIN32
+    gmtime_s(&tmValue, &value);
+#else
+    gmtime_r(&value, &tmValue);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), format, &tmValue);
+    return buffer;
+}
+}
+
+namespace fssm::generator {
+    uint64_t Random::next() {
+        // splitmix64
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t Random::range(uint32_t low, uint32_t high) {
+        if (high <= low) return low;
+        uint64_t span = static_cast<uint64_t>(high) - low + 1;
+        return static_cast<uint32_t>(low + next() % span);
+    }
+
+    parse::SL2File generate_save(const SaveOptions& options) {
+        switch (options.game) {
+            case Game::DSR: return generateDsr(options);
+            case Game::DS3: return generateDs3(options);
+            case Game::ER: return generateEr(options);
+            default:
+                throw std::invalid_argument(std::string("Generating saves is not supported for game ") + options.game.toString());
+        }
+    }
+
+    std::string save_filename(Game game) {
+        switch (game) {
+            case Game::DSR: return "DRAKS0005.sl2";
+            case Game::DS2_SOTFS: return "DS2SOFS0000.sl2";
+            case Game::DS3: return "DS30000.sl2";
+            case Game::Sekiro: return "S0000.sl2";
+            case Game::ER: return "ER0000.sl2";
+            default: return "";
+        }
+    }
+
+    std::vector<std::string> generate_backups(const std::string& backupRoot, const BackupsOptions& options) {
+        Random rng(options.save.seed);
+        std::string filename = save_filename(options.save.game);
+        std::filesystem::path gameDir = std::filesystem::path(backupRoot) / options.save.game.toString();
+        std::filesystem::create_directories(gameDir);
+
+        // Distinct saves are generated once and cycled, backups of one save usually differ only slightly
+        std::vector<std::vector<uint8_t>> saves;
+        if (!options.metadataOnly) {
+            int unique = std::clamp(options.unique, 1, std::max(1, options.count));
+            for (int i = 0; i < unique; ++i) {
+                SaveOptions saveOptions = options.save;
+                saveOptions.seed = options.save.seed + static_cast<uint64_t>(i);
+                parse::SL2File sl2 = generate_save(saveOptions);
+                saves.push_back(parse::build_sl2_content(sl2));
+            }
+        }
+
+        std::vector<std::string> output;
+        output.reserve(options.count);
+        for (int i = 0; i < options.count; ++i) {
+            int64_t epoch = options.startEpoch + static_cast<int64_t>(i) * 60;
+            std::filesystem::path backupDir = gameDir / formatTime(epoch, "%Y%m%d_%H%M%S");
+            std::filesystem::create_directories(backupDir);
+
+            if (!saves.empty()) {
+                const std::vector<uint8_t>& content = saves[i % saves.size()];
+                std::ofstream f(backupDir / filename, std::ios::binary | std::ios::trunc);
+                f.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+                if (!f) throw std::runtime_error("Failed to write backup save file");
+            }
+
+            uint32_t typeRoll = rng.range(0, 9);
+            std::string backupType = typeRoll < 7 ? "autosave" : (typeRoll < 9 ? "quicksave" : "manualsave");
+            json metadata = {
+                {"id", randomId(rng)},
+                {"game", options.save.game.toString()},
+                {"backup_type", backupType},
+                {"filenames", json::array({filename})},
+                {"datetime", formatTime(epoch, "%Y-%m-%dT%H:%M:%SZ")},
+                {"epoch", epoch},
+            };
+            if (backupType == "manualsave")
+                metadata["label"] = "Backup " + std::to_string(i);
+            else
+                metadata["label"] = nullptr;
+            std::ofstream o(backupDir / "metadata.json");
+            o << metadata.dump(4) << std::endl;
+            output.push_back(backupDir.string());
+        }
+        return output;
+    }
+}
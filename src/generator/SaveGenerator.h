@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "parse/Game.h"
+#include "parse/SL2File.h"
+
+namespace fssm::generator {
+    // Deterministic random generator, same sequence on all platforms for the same seed
+    class Random {
+    public:
+        explicit Random(uint64_t seed): m_state(seed) {}
+        uint64_t next();
+        // Value in inclusive range <low, high>
+        uint32_t range(uint32_t low, uint32_t high);
+        bool chance(uint32_t percent) { return range(0, 99) < percent; }
+    private:
+        uint64_t m_state;
+    };
+
+    struct SaveOptions {
+        Game game = Game::DSR;
+        uint64_t seed = 1;
+        // Number of occupied character slots (1-10)
+        int slots = 3;
+        // Items per character inventory and storage, negative value means random realistic count
+        int inventoryItems = -1;
+        int storageItems = -1;
+    };
+
+    // Build container with decrypted entries, use 'parse::write_sl2_file' to encrypt and store it
+    parse::SL2File generate_save(const SaveOptions& options);
+
+    struct BackupsOptions {
+        SaveOptions save;
+        // Number of backups to create and number of distinct saves cycled through backups
+        int count = 100;
+        int unique = 16;
+        // Write only metadata.json without save files
+        bool metadataOnly = false;
+        // Epoch of the first backup, following backups are created each minute
+        int64_t startEpoch = 1700000000;
+    };
+
+    // Create backups in the same layout as the application '{root}/{game}/{timestamp}/'
+    // Returns created backup directories
+    std::vector<std::string> generate_backups(const std::string& backupRoot, const BackupsOptions& options);
+
+    // Save filename used by the game
+    std::string save_filename(Game game);
+}
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "SaveGenerator.h"
+
+namespace {
+const char* USAGE = R"(Usage: fssm-gen-saves <command> [options]
+
+Commands:
+  save -o FILE         Generate one save file
+  backups -o ROOT      Generate backups with metadata.json in '{ROOT}/{game}/{timestamp}/'
+
+Options:
+  --game NAME          dsr, ds3 or er (default: dsr)
+  --seed N             Seed of random generator, same seed creates same output (default: 1)
+  --slots N            Occupied character slots 1-10 (default: 3)
+  --items N            Inventory items per character (default: random realistic count)
+  --storage N          Storage box items per character (default: random realistic count)
+  --count N            backups: Number of backups (default: 100)
+  --unique N           backups: Number of distinct saves cycled through backups (default: 16)
+  --metadata-only      backups: Write only metadata.json files
+)";
+
+struct Options {
+    std::string command;
+    std::string output;
+    fssm::generator::BackupsOptions backups;
+};
+
+std::optional<Options> parseArgs(int argc, char* argv[]) {
+    if (argc < 2) return std::nullopt;
+    Options options;
+    options.command = argv[1];
+    fssm::generator::SaveOptions& save = options.backups.save;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((arg == "-o" || arg == "--output") && hasValue) {
+            options.output = argv[++i];
+        } else if (arg == "--game" && hasValue) {
+            save.game = fssm::Game::fromString(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            save.seed = std::stoull(argv[++i]);
+        } else if (arg == "--slots" && hasValue) {
+            save.slots = std::stoi(argv[++i]);
+        } else if (arg == "--items" && hasValue) {
+            save.inventoryItems = std::stoi(argv[++i]);
+        } else if (arg == "--storage" && hasValue) {
+            save.storageItems = std::stoi(argv[++i]);
+        } else if (arg == "--count" && hasValue) {
+            options.backups.count = std::stoi(argv[++i]);
+        } else if (arg == "--unique" && hasValue) {
+            options.backups.unique = std::stoi(argv[++i]);
+        } else if (arg == "--metadata-only") {
+            options.backups.metadataOnly = true;
+        } else {
+            std::cerr << "Unknown option '" << arg << "'\n";
+            return std::nullopt;
+        }
+    }
+    if (options.output.empty()) return std::nullopt;
+    return options;
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::optional<Options> optionsOpt;
+    try {
+        optionsOpt = parseArgs(argc, argv);
+    } catch (const std::exception&) {
+        optionsOpt = std::nullopt;
+    }
+    if (!optionsOpt.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+    const Options& options = optionsOpt.value();
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        if (options.command == "save") {
+            fssm::parse::SL2File sl2 = fssm::generator::generate_save(options.backups.save);
+            fssm::parse::write_sl2_file(sl2, options.output);
+            std::cout << "Created " << options.output << " (" << std::filesystem::file_size(options.output) << " bytes)";
+        } else if (options.command == "backups") {
+            auto dirs = fssm::generator::generate_backups(options.output, options.backups);
+            std::cout << "Created " << dirs.size() << " backups in " << options.output;
+        } else {
+            std::cerr << "Unknown command '" << options.command << "'\n" << USAGE;
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed: " << e.what() << "\n";
+        return 1;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << " in " << elapsed.count() << " ms\n";
+    return 0;
+}
@@ -1,10 +1,36 @@
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFontDatabase>
+#include <QTimer>
+#include <iostream>
+#include <windows.h>
+#include <psapi.h>
 #include "ui/MainWindow.h"
 #include "ui/Controller.h"
 
+// Print time to first shown window and resident memory when 'FSSM_STARTUP_REPORT' is set
+// - used to compare qrc and asset pack builds
+static void printStartupReport(const QElapsedTimer& timer) {
+    PROCESS_MEMORY_COUNTERS counters;
+    size_t rssKib = 0;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        rssKib = counters.WorkingSetSize / 1024;
+#ifdef FSSM_USE_ASSET_PACK
+    const char* resources = "pack";
+#else
+    const char* resources = "qrc";
+#endif
+    std::cout << "startup_ms=" << timer.elapsed()
+        << " rss_kib=" << rssKib
+        << " resources=" << resources
+        << std::endl;
+}
+
 int main(int argc, char *argv[]) {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     QApplication app(argc, argv);
     app.setApplicationName("FromSoftSaveManager");
     app.setApplicationVersion(FSSM_VERSION);
@@ -22,5 +48,10 @@ int main(int argc, char *argv[]) {
     MainWindow window = MainWindow(&controller, nullptr);
     window.show();
 
+    if (qEnvironmentVariableIsSet("FSSM_STARTUP_REPORT")) {
+        // Queued to event loop so the first frame is already painted
+        QTimer::singleShot(0, &app, [&startupTimer]() { printStartupReport(startupTimer); });
+    }
+
     return QApplication::exec();
 }
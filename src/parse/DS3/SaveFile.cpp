@@ -2,26 +2,71 @@
 
 #include <cstring>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
 
+#include "../Metrics.h"
+#include "../Trace.h"
 #include "../Utils.h"
 
 constexpr std::array<uint8_t, 8> g_SkipValue = {0, 0, 0, 0, 255, 255, 255, 255};
-
-int findInitialOffset(const std::vector<uint8_t>& content) {
-    int offset = 108;
-    std::array<uint8_t, 8> tmp;
+// Layout of menu entry (USER_DATA010)
+constexpr size_t MENU_OCCUPIED_OFFSET = 4244;
+constexpr size_t MENU_SLOTS_OFFSET = 4254;
+constexpr size_t MENU_SLOT_SIZE = 554;
+
+// Records before character stats are 8 bytes long if empty (g_SkipValue), 60 bytes otherwise
+static size_t findInitialOffset(const std::vector<uint8_t>& content) {
+    uint64_t skipWord;
+    std::memcpy(&skipWord, g_SkipValue.data(), sizeof(skipWord));
+    const uint8_t* data = content.data();
+    const size_t size = content.size();
+    size_t offset = 108;
     for (int i = 0; i < 6144; ++i) {
-        std::memcpy(tmp.data(), content.data() + offset, 8);
-        if (tmp == g_SkipValue) {
-            offset += 8;
-        } else {
-            offset += 60;
+        if (offset + 8 > size) {
+            throw fssm::parse::ParseException(
+                fssm::parse::ParseErrorCode::OutOfBounds,
+                static_cast<int64_t>(offset),
+                "Records before character stats past end of entry"
+            );
         }
+#if defined(__GNUC__)
+        __builtin_prefetch(data + offset + 512);
+#endif
+        uint64_t word;
+        std::memcpy(&word, data + offset, sizeof(word));
+        offset += word == skipWord ? 8 : 60;
     }
     return offset;
 }
 
 namespace fssm::parse::ds3 {
+    std::optional<size_t> InitialOffsetCache::get(const BND4Entry& entry, const uint8_t& index) const {
+        if (index >= m_items.size()) return std::nullopt;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Item& item = m_items[index];
+        if (item.offset == 0 || item.contentSize != entry.content.size() || item.checksum != entry.checksum) {
+            return std::nullopt;
+        }
+        return item.offset;
+    }
+
+    void InitialOffsetCache::set(const BND4Entry& entry, const uint8_t& index, size_t offset) {
+        if (index >= m_items.size()) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_items[index] = {entry.checksum, entry.content.size(), offset};
+    }
+
+    // Scan result depends only on entry content, skip the scan if slot did not change since last parse
+    static size_t getInitialOffset(const BND4Entry& entry, const uint8_t& index, InitialOffsetCache* cache) {
+        if (cache != nullptr) {
+            if (auto offset = cache->get(entry, index)) return *offset;
+        }
+        size_t offset = findInitialOffset(entry.content);
+        if (cache != nullptr) cache->set(entry, index, offset);
+        return offset;
+    }
+
     Infusion infusionFromInt(const uint32_t& infusion) {
         switch (infusion) {
             case 0:
@@ -111,22 +156,24 @@ namespace fssm::parse::ds3 {
         return invItem;
     }
 
-    DS3CharacterInfo parse_ds3_character(const BND4Entry& entry, const BND4Entry& menuEntry, const uint8_t& index) {
+    DS3CharacterInfo parse_ds3_character(
+        const BND4Entry& entry, const BND4Entry& menuEntry, const uint8_t& index, InitialOffsetCache* cache
+    ) {
+        FSSM_TRACE_SCOPE_ARG("ds3.parse_character", index);
         // Get name from menu entry
-        int menuOffset = 4254 + (554 * index);
+        size_t menuOffset = MENU_SLOTS_OFFSET + (MENU_SLOT_SIZE * index);
+        if (index >= 10 || menuEntry.content.size() < menuOffset + 32) {
+            throw ParseException(
+                ParseErrorCode::OutOfBounds, static_cast<int64_t>(menuOffset), "Character slot out of menu entry bounds"
+            );
+        }
         std::vector<uint8_t> name_b;
         name_b.assign(menuEntry.content.begin() + menuOffset, menuEntry.content.begin() + menuOffset + 32);
         std::u16string name = parse_name(name_b);
 
-        ContentReader reader(entry.content);
-
-        reader.skip(108);
+        ContentReader reader(entry.content, index);
 
-        std::array<uint8_t, 8> tmp;
-        for (int i = 0; i < 6144; ++i) {
-            reader.copyTo(&tmp, sizeof(tmp));
-            if (tmp != g_SkipValue) reader.skip(52);
-        }
+        reader.skip(getInitialOffset(entry, index, cache));
         reader.skip(8);
 
         uint32_t hpCurrent = reader.read_u32_le();
@@ -230,7 +277,7 @@ namespace fssm::parse::ds3 {
         //     auto invItemOpt = InventoryItem::fromId(itemId, 1);
         //     if (invItemOpt.has_value()) maybeTools.push_back(invItemOpt.value());
         // }
-        reader.skip(maybeToolsCount * 8);
+        reader.skip(static_cast<size_t>(maybeToolsCount) * 8);
 
         // auto lHand1Equip = InventoryItem::fromId(read_u32_le(c + offset), 1);
         // auto rHand1Equip = InventoryItem::fromId(read_u32_le(c + offset + 4), 1);
@@ -312,29 +359,69 @@ namespace fssm::parse::ds3 {
             .hollowing = hollowing,
             .estusMax = estusMax,
             .ashenEstusMax = ashenEstusMax,
-            .inventoryItems = inventoryItems,
-            .keyItems = keyItems,
-            .storageBoxItems = storageBoxItems,
+            .inventoryItems = std::move(inventoryItems),
+            .keyItems = std::move(keyItems),
+            .storageBoxItems = std::move(storageBoxItems),
+            .checksum = entry.checksum,
         };
     }
 
-    DS3SaveFile parse_ds3_file(const SL2File& sl2) {
+    static DS3SaveFile parseDs3File(const SL2File& sl2, InitialOffsetCache* cache) {
+        auto start = std::chrono::steady_clock::now();
         auto& menuEntry = sl2.entries[10];
         uint64_t steamId = read_u64_le(menuEntry.content.data() + 4);
         std::array<uint8_t, 10> occupiedSlots;
-        std::memcpy(occupiedSlots.data(), menuEntry.content.data() + 4244, 10);
+        std::memcpy(occupiedSlots.data(), menuEntry.content.data() + MENU_OCCUPIED_OFFSET, 10);
 
         std::vector<DS3CharacterInfo> characters;
         characters.reserve(10);
         for (int i = 0; i < 10; ++i) {
             if (occupiedSlots[i] == 1)
-                characters.push_back(parse_ds3_character(sl2.entries[i], menuEntry, i));
+                characters.push_back(parse_ds3_character(sl2.entries[i], menuEntry, i, cache));
         }
 
-        return {
-            characters,
-            menuEntry,
-            sl2.entries[11]
-        };
+        metrics::latency("parse.DS3").record(start);
+        DS3SaveFile saveFile;
+        saveFile.characters = std::move(characters);
+        return saveFile;
+    }
+
+    static std::optional<ParseError> checkDs3File(const SL2File& sl2) {
+        if (sl2.entries.size() < 12) {
+            return ParseError{ParseErrorCode::MissingEntries, -1, "Expected 12 entries in DS3 save file"};
+        }
+        // Occupied flags and summary of all slots must be in the menu entry
+        if (sl2.entries[10].content.size() < MENU_SLOTS_OFFSET + MENU_SLOT_SIZE * 10) {
+            return ParseError{
+                ParseErrorCode::InvalidEntry,
+                static_cast<int64_t>(sl2.entries[10].content.size()),
+                "Menu entry (10) is too small"
+            };
+        }
+        return std::nullopt;
+    }
+
+    ParseResult<DS3SaveFile> try_parse_ds3_file(const SL2File& sl2, InitialOffsetCache* cache) {
+        if (auto error = checkDs3File(sl2)) return *error;
+        return catch_parse_error([&sl2, cache]() {
+            DS3SaveFile saveFile = parseDs3File(sl2, cache);
+            saveFile.menuEntry = std::make_shared<const BND4Entry>(sl2.entries[10]);
+            saveFile.sideCarEnty = std::make_shared<const BND4Entry>(sl2.entries[11]);
+            return saveFile;
+        });
+    }
+
+    ParseResult<DS3SaveFile> try_parse_ds3_file(SL2File&& sl2, InitialOffsetCache* cache) {
+        if (auto error = checkDs3File(sl2)) return *error;
+        return catch_parse_error([&sl2, cache]() {
+            DS3SaveFile saveFile = parseDs3File(sl2, cache);
+            saveFile.menuEntry = std::make_shared<const BND4Entry>(std::move(sl2.entries[10]));
+            saveFile.sideCarEnty = std::make_shared<const BND4Entry>(std::move(sl2.entries[11]));
+            return saveFile;
+        });
+    }
+
+    DS3SaveFile parse_ds3_file(const SL2File& sl2, InitialOffsetCache* cache) {
+        return try_parse_ds3_file(sl2, cache).value();
     }
 }
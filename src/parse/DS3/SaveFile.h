@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <string>
 #include "Items.h"
@@ -55,13 +59,41 @@ namespace fssm::parse::ds3 {
         std::vector<InventoryItem> inventoryItems;
         std::vector<InventoryItem> keyItems;
         std::vector<InventoryItem> storageBoxItems;
+
+        // Checksum of slot entry, used to detect changed characters
+        std::array<uint8_t, 16> checksum{};
     };
 
     struct DS3SaveFile {
         std::vector<DS3CharacterInfo> characters;
-        BND4Entry menuEntry;
-        BND4Entry sideCarEnty;
+        // Shared so copies of parsed save don't copy the entries content
+        std::shared_ptr<const BND4Entry> menuEntry;
+        std::shared_ptr<const BND4Entry> sideCarEnty;
+    };
+
+    // Offsets of character stats in slot entries, scan of records before them is skipped for unchanged slots
+    // - owned by caller, use one cache per save file (slots are matched by index, checksum and size)
+    // - can be shared between threads
+    class InitialOffsetCache {
+    public:
+        std::optional<size_t> get(const BND4Entry& entry, const uint8_t& index) const;
+        void set(const BND4Entry& entry, const uint8_t& index, size_t offset);
+    private:
+        struct Item {
+            std::array<uint8_t, 16> checksum{};
+            size_t contentSize = 0;
+            size_t offset = 0;
+        };
+        mutable std::mutex m_mutex;
+        std::array<Item, 10> m_items{};
     };
-    DS3CharacterInfo parse_ds3_character(const BND4Entry& entry, const BND4Entry& menuEntry, const uint8_t& index);
-    DS3SaveFile parse_ds3_file(const SL2File& sl2);
+
+    DS3CharacterInfo parse_ds3_character(
+        const BND4Entry& entry, const BND4Entry& menuEntry, const uint8_t& index, InitialOffsetCache* cache = nullptr
+    );
+    DS3SaveFile parse_ds3_file(const SL2File& sl2, InitialOffsetCache* cache = nullptr);
+    // Damaged entries are returned as error, offset of the error is in entry content
+    ParseResult<DS3SaveFile> try_parse_ds3_file(const SL2File& sl2, InitialOffsetCache* cache = nullptr);
+    // Moves entries kept by parsed save out of 'sl2' instead of copying them
+    ParseResult<DS3SaveFile> try_parse_ds3_file(SL2File&& sl2, InitialOffsetCache* cache = nullptr);
 }
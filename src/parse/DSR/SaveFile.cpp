@@ -3,6 +3,8 @@
 #include <iostream>
 #include <locale>
 #include <optional>
+#include "../Metrics.h"
+#include "../Trace.h"
 #include "../Utils.h"
 
 namespace fssm::parse::dsr {
@@ -90,9 +92,10 @@ namespace fssm::parse::dsr {
         invItem.baseItem.label = "Unknown " + std::to_string(invItem.itemId);
     }
 
-    DSRSaveFile parse_dsr_file(const SL2File& sl2) {
+    static DSRSaveFile parseDsrFile(const SL2File& sl2) {
+        auto start = std::chrono::steady_clock::now();
         // Read USERDATA_10 to get
-        ContentReader sideEntryReader(sl2.entries[10].content);
+        ContentReader sideEntryReader(sl2.entries[10].content, 10);
         sideEntryReader.skip(176);
         std::array<uint8_t, 10> occupiedSlots;
         sideEntryReader.copyTo(occupiedSlots.data(), 10);
@@ -101,11 +104,13 @@ namespace fssm::parse::dsr {
         characters.reserve(10);
         for (int charIdx = 0; charIdx < sl2.entries.size() && charIdx < 10; ++charIdx) {
             if (occupiedSlots[charIdx] == 0) continue;
-            ContentReader reader(sl2.entries[charIdx].content);
+            FSSM_TRACE_SCOPE_ARG("dsr.parse_character", charIdx);
+            ContentReader reader(sl2.entries[charIdx].content, charIdx);
             reader.skip(4);
 
             DSRCharacterInfo ci;
             ci.index = charIdx;
+            ci.checksum = sl2.entries[charIdx].checksum;
 
             reader.skip(92);
             ci.hpCurrent = reader.read_u32_le();
@@ -285,10 +290,36 @@ namespace fssm::parse::dsr {
             characters.push_back(std::move(ci));
         }
         // TODO implemet rest of file
-        DSRSaveFile save_file = {
-            .characters = characters,
-            .sideCarEnty = sl2.entries[10]
-        };
+        DSRSaveFile save_file;
+        save_file.characters = std::move(characters);
+        metrics::latency("parse.DSR").record(start);
         return save_file;
     }
+
+    static std::optional<ParseError> checkDsrFile(const SL2File& sl2) {
+        if (sl2.entries.size() >= 11) return std::nullopt;
+        return ParseError{ParseErrorCode::MissingEntries, -1, "Expected 11 entries in DSR save file"};
+    }
+
+    ParseResult<DSRSaveFile> try_parse_dsr_file(const SL2File& sl2) {
+        if (auto error = checkDsrFile(sl2)) return *error;
+        return catch_parse_error([&sl2]() {
+            DSRSaveFile saveFile = parseDsrFile(sl2);
+            saveFile.sideCarEnty = std::make_shared<const BND4Entry>(sl2.entries[10]);
+            return saveFile;
+        });
+    }
+
+    ParseResult<DSRSaveFile> try_parse_dsr_file(SL2File&& sl2) {
+        if (auto error = checkDsrFile(sl2)) return *error;
+        return catch_parse_error([&sl2]() {
+            DSRSaveFile saveFile = parseDsrFile(sl2);
+            saveFile.sideCarEnty = std::make_shared<const BND4Entry>(std::move(sl2.entries[10]));
+            return saveFile;
+        });
+    }
+
+    DSRSaveFile parse_dsr_file(const SL2File& sl2) {
+        return try_parse_dsr_file(sl2).value();
+    }
 }
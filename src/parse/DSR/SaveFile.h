@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -92,12 +93,20 @@ namespace fssm::parse::dsr {
         std::vector<AttunementSlot> attunementSlots;
         std::array<uint16_t, 18> usedGestures;
         std::vector<InventoryItem> bottomlessBoxItems;
+
+        // Checksum of slot entry, used to detect changed characters
+        std::array<uint8_t, 16> checksum{};
     };
 
     struct DSRSaveFile {
         std::vector<DSRCharacterInfo> characters;
-        BND4Entry sideCarEnty;
+        // Shared so copies of parsed save don't copy the entry content
+        std::shared_ptr<const BND4Entry> sideCarEnty;
     };
 
     DSRSaveFile parse_dsr_file(const SL2File& sl2);
+    // Damaged entries are returned as error, offset of the error is in entry content
+    ParseResult<DSRSaveFile> try_parse_dsr_file(const SL2File& sl2);
+    // Moves entries kept by parsed save out of 'sl2' instead of copying them
+    ParseResult<DSRSaveFile> try_parse_dsr_file(SL2File&& sl2);
 }
@@ -0,0 +1,105 @@
+#include "GaItemTable.h"
+
+
+namespace fssm::parse::er {
+void GaItemTable::reserve(size_t count) {
+    m_handles.reserve(count);
+    m_itemIds.reserve(count);
+    m_unknown1.reserve(count);
+    m_unknown2.reserve(count);
+    m_gemHandles.reserve(count);
+    m_unknown3.reserve(count);
+    // Keep load factor at most 0.5
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+    if (capacity > m_index.size()) rehash(capacity);
+}
+
+void GaItemTable::push(const GaItem& item) {
+    uint32_t idx = static_cast<uint32_t>(m_handles.size());
+    m_handles.push_back(item.handle);
+    m_itemIds.push_back(item.itemId);
+    m_unknown1.push_back(item.unknown1);
+    m_unknown2.push_back(item.unknown2);
+    m_gemHandles.push_back(item.gamhandle);
+    m_unknown3.push_back(item.unknown3);
+    if (item.handle == 0) return;
+    if ((m_indexed + 1) * 2 > m_index.size()) {
+        rehash(m_index.empty() ? 16 : m_index.size() * 2);
+    }
+    insertIndex(item.handle, idx);
+}
+
+void GaItemTable::clear() {
+    m_handles.clear();
+    m_itemIds.clear();
+    m_unknown1.clear();
+    m_unknown2.clear();
+    m_gemHandles.clear();
+    m_unknown3.clear();
+    m_index.assign(m_index.size(), {0, 0});
+    m_indexed = 0;
+}
+
+GaItem GaItemTable::at(size_t idx) const {
+    return {
+        m_handles.at(idx),
+        m_itemIds[idx],
+        m_unknown1[idx],
+        m_unknown2[idx],
+        m_gemHandles[idx],
+        m_unknown3[idx],
+    };
+}
+
+std::optional<size_t> GaItemTable::indexOf(uint32_t handle) const {
+    if (handle == 0 || m_index.empty()) return std::nullopt;
+    const size_t mask = m_index.size() - 1;
+    for (size_t slot = slotFor(handle);; slot = (slot + 1) & mask) {
+        const IndexSlot& item = m_index[slot];
+        if (item.handle == handle) return item.idx;
+        if (item.handle == 0) return std::nullopt;
+    }
+}
+
+std::optional<GaItem> GaItemTable::find(uint32_t handle) const {
+    std::optional<size_t> idx = indexOf(handle);
+    if (!idx.has_value()) return std::nullopt;
+    return at(idx.value());
+}
+
+uint32_t GaItemTable::itemIdOf(uint32_t handle) const {
+    std::optional<size_t> idx = indexOf(handle);
+    if (!idx.has_value()) return 0;
+    return m_itemIds[idx.value()];
+}
+
+size_t GaItemTable::slotFor(uint32_t handle) const {
+    // Fibonacci hashing, handles are mostly sequential within each type
+    return static_cast<uint32_t>(handle * 2654435769u) >> m_shift;
+}
+
+void GaItemTable::insertIndex(uint32_t handle, uint32_t idx) {
+    const size_t mask = m_index.size() - 1;
+    for (size_t slot = slotFor(handle);; slot = (slot + 1) & mask) {
+        IndexSlot& item = m_index[slot];
+        if (item.handle == 0) {
+            item = {handle, idx};
+            ++m_indexed;
+            return;
+        }
+        // Duplicated handle, keep the first record
+        if (item.handle == handle) return;
+    }
+}
+
+void GaItemTable::rehash(size_t capacity) {
+    m_index.assign(capacity, {0, 0});
+    m_indexed = 0;
+    m_shift = 32;
+    while ((size_t{1} << (32 - m_shift)) < capacity) --m_shift;
+    for (size_t idx = 0; idx < m_handles.size(); ++idx) {
+        if (m_handles[idx] != 0) insertIndex(m_handles[idx], static_cast<uint32_t>(idx));
+    }
+}
+}
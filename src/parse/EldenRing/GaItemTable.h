@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace fssm::parse::er {
+struct GaItem {
+    uint32_t handle;
+    uint32_t itemId;
+    uint32_t unknown1;
+    uint32_t unknown2;
+    uint32_t gamhandle;
+    uint8_t unknown3;
+};
+
+// GaItem records stored as struct of arrays with open addressing index from handle to record
+class GaItemTable {
+public:
+    void reserve(size_t count);
+    void push(const GaItem& item);
+    void clear();
+
+    size_t size() const { return m_handles.size(); }
+    bool empty() const { return m_handles.empty(); }
+    GaItem at(size_t idx) const;
+
+    // Index of record with handle, empty handle (0) is never indexed
+    std::optional<size_t> indexOf(uint32_t handle) const;
+    std::optional<GaItem> find(uint32_t handle) const;
+    // Item id of record with handle, 0 if handle is unknown
+    uint32_t itemIdOf(uint32_t handle) const;
+
+    const std::vector<uint32_t>& handles() const { return m_handles; }
+    const std::vector<uint32_t>& itemIds() const { return m_itemIds; }
+
+private:
+    struct IndexSlot {
+        uint32_t handle;
+        uint32_t idx;
+    };
+    size_t slotFor(uint32_t handle) const;
+    void insertIndex(uint32_t handle, uint32_t idx);
+    void rehash(size_t capacity);
+
+    std::vector<uint32_t> m_handles;
+    std::vector<uint32_t> m_itemIds;
+    std::vector<uint32_t> m_unknown1;
+    std::vector<uint32_t> m_unknown2;
+    std::vector<uint32_t> m_gemHandles;
+    std::vector<uint8_t> m_unknown3;
+
+    std::vector<IndexSlot> m_index;
+    size_t m_indexed = 0;
+    uint32_t m_shift = 32;
+};
+}
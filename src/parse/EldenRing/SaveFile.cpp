@@ -1,16 +1,155 @@
 #include "SaveFile.h"
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
 #include <ostream>
+#include <stdexcept>
 
+#include "../Metrics.h"
+#include "../Trace.h"
 #include "../Utils.h"
 
 
 namespace fssm::parse::er {
+static ItemType itemTypeFromHandle(const uint32_t& handle) {
+    switch (handle & 0xf0000000) {
+        case 0x80000000: return ItemType::Weapon;
+        case 0x90000000: return ItemType::Armor;
+        case 0xa0000000: return ItemType::Talisman;
+        case 0xb0000000: return ItemType::Goods;
+        case 0xc0000000: return ItemType::AshOfWar;
+        default: return ItemType::Unknown;
+    }
+}
+
+// Inventory records are {gaitem handle, quantity, acquisition index}
+static void readInventoryItems(
+    ContentReader& reader,
+    const GaItemTable& gaItems,
+    const size_t& count,
+    const bool& isKeyItem,
+    std::vector<InventoryItem>& output
+) {
+    for (size_t idx = 0; idx < count; ++idx) {
+        uint32_t handle = reader.read_u32_le();
+        uint32_t amount = reader.read_u32_le();
+        uint32_t order = reader.read_u32_le();
+        if (handle == 0 || handle == 0xffffffff) continue;
+
+        ItemType type = itemTypeFromHandle(handle);
+        uint32_t itemId = 0;
+        switch (type) {
+            // Talismans and goods are not stored as GaItem, handle contains the item id
+            case ItemType::Talisman:
+                itemId = (handle & 0x0fffffff) | 0x20000000;
+                break;
+            case ItemType::Goods:
+                itemId = (handle & 0x0fffffff) | 0x40000000;
+                break;
+            case ItemType::Unknown:
+                continue;
+            default:
+                itemId = gaItems.itemIdOf(handle);
+                break;
+        }
+        if (itemId == 0 || itemId == 0xffffffff) continue;
+
+        uint8_t upgradeLevel = 0;
+        if (type == ItemType::Weapon) upgradeLevel = (itemId & 0x0fffffff) % 100;
+        output.push_back({
+            .gaItemHandle = handle,
+            .itemId = itemId,
+            .amount = amount,
+            .order = order,
+            .type = type,
+            .upgradeLevel = upgradeLevel,
+            .isKeyItem = isKeyItem,
+        });
+    }
+}
+
+static void readInventory(
+    ContentReader& reader,
+    const GaItemTable& gaItems,
+    const size_t& commonCount,
+    const size_t& keyCount,
+    std::vector<InventoryItem>& output
+) {
+    uint32_t commonDistinct = reader.read_u32_le();
+    // Distinct count is read from file, don't trust it for allocation
+    output.reserve(std::min<size_t>(commonDistinct, commonCount));
+    readInventoryItems(reader, gaItems, commonCount, false, output);
+    reader.read_u32_le();
+    readInventoryItems(reader, gaItems, keyCount, true, output);
+    // next equip index, next acquisition sort id
+    reader.skip(8);
+}
+
+static void readSummaryEquipmentGaItem(ContentReader& reader, SummaryEquipmentGaItem& output) {
+    output.unknown1 = reader.read_u32_le();
+    output.unknown2 = reader.read_u32_le();
+    output.armStyle = reader.read_u32_le();
+    output.leftHandActiveSlot = reader.read_u32_le();
+    output.rightHandActiveSlot = reader.read_u32_le();
+    output.leftArrowActiveSlot = reader.read_u32_le();
+    output.rightArrowActiveSlot = reader.read_u32_le();
+    output.leftBoltActiveSlot = reader.read_u32_le();
+    output.rightBoltActiveSlot = reader.read_u32_le();
+    for (auto& value: output.leftHandArmaments) value = reader.read_u32_le();
+    for (auto& value: output.rightHandArmaments) value = reader.read_u32_le();
+    for (auto& value: output.arrows) value = reader.read_u32_le();
+    for (auto& value: output.bolts) value = reader.read_u32_le();
+    output.unknown3 = reader.read_u32_le();
+    output.head = reader.read_u32_le();
+    output.chest = reader.read_u32_le();
+    output.arms = reader.read_u32_le();
+    output.legs = reader.read_u32_le();
+    output.unknown4 = reader.read_u32_le();
+    for (auto& value: output.talismans) value = reader.read_u32_le();
+    output.unknown5 = reader.read_u32_le();
+}
+
+static void readSummaryEquipmentItem(ContentReader& reader, SummaryEquipmentItem& output) {
+    for (auto& value: output.leftHandArmaments) value = reader.read_u32_le();
+    for (auto& value: output.rightHandArmaments) value = reader.read_u32_le();
+    output.unknown1 = reader.read_u32_le();
+    for (auto& value: output.arrows) value = reader.read_u32_le();
+    for (auto& value: output.bolts) value = reader.read_u32_le();
+    output.unknown2 = reader.read_u32_le();
+    output.head = reader.read_u32_le();
+    output.chest = reader.read_u32_le();
+    output.arms = reader.read_u32_le();
+    output.legs = reader.read_u32_le();
+    output.unknown3 = reader.read_u32_le();
+    for (auto& value: output.talismans) value = reader.read_u32_le();
+    for (auto& value: output.unknown4) value = reader.read_u32_le();
+}
+
+static void readSlotSummary(ContentReader& reader, SlotSummary& output) {
+    output.name = reader.read_u16_string(17);
+    output.level = reader.read_u32_le();
+    output.unknown1 = reader.read_u32_le();
+    output.unknown2 = reader.read_u32_le();
+    output.unknown3 = reader.read_u32_le();
+    output.unknown4 = reader.read_u32_le();
+    output.unknown5 = reader.read_u32_le();
+    reader.copyTo(&output.unknown6, sizeof(output.unknown6));
+    readSummaryEquipmentGaItem(reader, output.equipmentGaItem);
+    readSummaryEquipmentItem(reader, output.equipmentItem);
+    output.unknown7 = reader.read_u8_le();
+    output.unknown8 = reader.read_u8_le();
+    output.unknown9 = reader.read_u8_le();
+    output.unknown10 = reader.read_u8_le();
+    output.unknown11 = reader.read_u8_le();
+    output.unknown12 = reader.read_u8_le();
+    output.unknown13 = reader.read_i32_le();
+}
+
 UserData10 parseUserData10(const BND4Entry& entry) {
+    FSSM_TRACE_SCOPE("er.parse_user_data");
     UserData10 output;
-    ContentReader reader = ContentReader(entry.content);
+    ContentReader reader = ContentReader(entry.content, 10);
     output.version = reader.read_u32_le();
     output.steamId = reader.read_u64_le();
     reader.copyTo(&output.settings, sizeof(output.settings));
@@ -19,13 +158,20 @@ UserData10 parseUserData10(const BND4Entry& entry) {
     output.menuSystemSaveLoad.length = reader.read_u32_le();
     output.menuSystemSaveLoad.data = reader.read_vec_u8(output.menuSystemSaveLoad.length);
     reader.copyTo(&output.slotsSummary.occupied, sizeof(output.slotsSummary.occupied));
+    for (int i = 0; i < 10; ++i) {
+        SlotSummary& slot = output.slotsSummary.slots[i];
+        slot.index = i;
+        readSlotSummary(reader, slot);
+    }
     // TODO do rest
     return output;
 }
 
-ERCharacterInfo parseERCharacter(const BND4Entry& entry, const UserData10& userData10, const uint8_t& index) {
+ERCharacterInfo parseERCharacter(const BND4Entry& entry, const uint8_t& index) {
+    FSSM_TRACE_SCOPE_ARG("er.parse_character", index);
     ERCharacterInfo output;
     output.index = index;
+    output.checksum = entry.checksum;
 
     ContentReader reader = ContentReader(entry.content);
     output.version = reader.read_u32_le();
@@ -55,7 +201,7 @@ ERCharacterInfo parseERCharacter(const BND4Entry& entry, const UserData10& userD
                 gaUnknown2 = reader.read_u32_le();
             }
         }
-        output.gaItems.push_back({
+        output.gaItems.push({
             handle,
             itemId,
             gaUnknown1,
@@ -97,20 +243,108 @@ ERCharacterInfo parseERCharacter(const BND4Entry& entry, const UserData10& userD
 
     output.name = reader.read_u16_string(16);
 
+    // Rest of player game data
+    reader.skip(252);
+    // Active special effects
+    reader.skip(208);
+    // Equipped items equip indexes, active weapon slots, equipped item ids and gaitem handles
+    reader.skip(88 + 28 + 88 + 88);
+
+    readInventory(reader, output.gaItems, 2688, 384, output.inventoryItems);
+
+    // Equipped spells, items and gestures
+    reader.skip(116 + 140 + 24);
+    uint32_t projectilesCount = reader.read_u32_le();
+    if (projectilesCount > 1024) {
+        throw ParseException(
+            ParseErrorCode::InvalidValue,
+            static_cast<int64_t>(reader.pos() - 4),
+            "Invalid projectiles count " + std::to_string(projectilesCount) + " in entry " + std::to_string(index)
+        );
+    }
+    reader.skip(8 * static_cast<size_t>(projectilesCount));
+    // Equipped armaments and items, physics and face data
+    reader.skip(156 + 12 + 303);
+
+    readInventory(reader, output.gaItems, 1920, 128, output.storageItems);
+
     return output;
 }
 
-ERSaveFile parse_er_file(const SL2File& sl2) {
+static std::optional<ParseError> checkEntriesCount(const SL2File& sl2) {
+    if (sl2.entries.size() >= 12) return std::nullopt;
+    return ParseError{ParseErrorCode::MissingEntries, -1, "Expected 12 entries in Elden Ring save file"};
+}
+
+static UserData10 parseUserData10WithChecksums(const SL2File& sl2) {
     UserData10 userData10 = parseUserData10(sl2.entries[10]);
+    for (int i = 0; i < 10; ++i) {
+        userData10.slotsSummary.slots[i].checksum = sl2.entries[i].checksum;
+    }
+    return userData10;
+}
 
-    ERSaveFile saveFile {
-        .userData10 = userData10,
-        .sideCarEnty = sl2.entries[11],
-    };
+static ERSaveFile parseErFile(const SL2File& sl2) {
+    auto start = std::chrono::steady_clock::now();
+    ERSaveFile saveFile;
+    saveFile.userData10 = parseUserData10WithChecksums(sl2);
     for (int i = 0; i < 10; ++i) {
-        if (userData10.slotsSummary.occupied[i] == 0) continue;
-        saveFile.characters.push_back(parseERCharacter(sl2.entries[i], userData10, i));
+        if (saveFile.userData10.slotsSummary.occupied[i] == 0) continue;
+        saveFile.characters.push_back(parseERCharacter(sl2.entries[i], i));
     }
+    metrics::latency("parse.ER").record(start);
     return saveFile;
 }
+
+ParseResult<ERSaveFile> try_parse_er_file(const SL2File& sl2) {
+    if (auto error = checkEntriesCount(sl2)) return *error;
+    return catch_parse_error([&sl2]() {
+        ERSaveFile saveFile = parseErFile(sl2);
+        saveFile.sideCarEnty = std::make_shared<const BND4Entry>(sl2.entries[11]);
+        return saveFile;
+    });
+}
+
+ParseResult<ERSaveFile> try_parse_er_file(SL2File&& sl2) {
+    if (auto error = checkEntriesCount(sl2)) return *error;
+    return catch_parse_error([&sl2]() {
+        ERSaveFile saveFile = parseErFile(sl2);
+        saveFile.sideCarEnty = std::make_shared<const BND4Entry>(std::move(sl2.entries[11]));
+        return saveFile;
+    });
+}
+
+ParseResult<UserData10> try_parse_er_user_data(const SL2File& sl2) {
+    if (auto error = checkEntriesCount(sl2)) return *error;
+    return catch_parse_error([&sl2]() {
+        auto start = std::chrono::steady_clock::now();
+        UserData10 userData10 = parseUserData10WithChecksums(sl2);
+        metrics::latency("parse.ER.summary").record(start);
+        return userData10;
+    });
+}
+
+ParseResult<ERCharacterInfo> try_parse_er_character(const SL2File& sl2, const uint8_t& index) {
+    if (index >= 10 || index >= sl2.entries.size()) {
+        return ParseError{ParseErrorCode::InvalidValue, -1, "Invalid character index " + std::to_string(index)};
+    }
+    return catch_parse_error([&sl2, index]() {
+        auto start = std::chrono::steady_clock::now();
+        ERCharacterInfo character = parseERCharacter(sl2.entries[index], index);
+        metrics::latency("parse.ER.character").record(start);
+        return character;
+    });
+}
+
+ERSaveFile parse_er_file(const SL2File& sl2) {
+    return try_parse_er_file(sl2).value();
+}
+
+UserData10 parse_er_user_data(const SL2File& sl2) {
+    return try_parse_er_user_data(sl2).value();
+}
+
+ERCharacterInfo parse_er_character(const SL2File& sl2, const uint8_t& index) {
+    return try_parse_er_character(sl2, index).value();
+}
 }
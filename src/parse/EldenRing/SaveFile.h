@@ -1,21 +1,39 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "GaItemTable.h"
 #include "../SL2File.h"
 
 
 namespace fssm::parse::er {
-struct GaItem {
-    uint32_t handle;
+enum class ItemType {
+    Weapon,
+    Armor,
+    Talisman,
+    Goods,
+    AshOfWar,
+    Unknown,
+};
+
+struct InventoryItem {
+    uint32_t gaItemHandle;
+    // Item id with type bits (e.g. 0x40000000 for goods)
     uint32_t itemId;
-    uint32_t unknown1;
-    uint32_t unknown2;
-    uint32_t gamhandle;
-    uint8_t unknown3;
+    uint32_t amount;
+    // Acquisition index used by game for sorting
+    uint32_t order;
+    ItemType type;
+    uint8_t upgradeLevel;
+    bool isKeyItem;
+
+    // Item id without type bits and upgrade level
+    uint32_t baseId() const { return (itemId & 0x0fffffff) - upgradeLevel; }
 };
+
 struct ERCharacterInfo {
     int index;
     uint32_t version;
@@ -23,7 +41,7 @@ struct ERCharacterInfo {
     std::array<uint8_t, 8> unknown1;
     std::array<uint8_t, 16> unknown2;
 
-    std::vector<GaItem> gaItems;
+    GaItemTable gaItems;
 
     std::u16string name;
     uint32_t runes;
@@ -48,6 +66,12 @@ struct ERCharacterInfo {
     uint32_t intelligence;
     uint32_t faith;
     uint32_t arcane;
+
+    std::vector<InventoryItem> inventoryItems;
+    std::vector<InventoryItem> storageItems;
+
+    // Checksum of slot entry, used to detect changed characters
+    std::array<uint8_t, 16> checksum{};
 };
 
 struct MenuSystemSaveLoad {
@@ -98,6 +122,8 @@ struct SummaryEquipmentItem {
 };
 
 struct SlotSummary {
+    // Slot index, not stored in file
+    int index;
     std::u16string name;
     uint32_t level;
     uint32_t unknown1;
@@ -115,11 +141,13 @@ struct SlotSummary {
     uint8_t unknown11;
     uint8_t unknown12;
     int32_t unknown13;
+    // Checksum of slot entry, not stored in summary, used to detect changed characters
+    std::array<uint8_t, 16> checksum{};
 };
 
 struct SlotsSummary {
     std::array<uint8_t, 10> occupied;
-    // std::array<SlotSummary, 10> slots;
+    std::array<SlotSummary, 10> slots;
 };
 
 struct UserData10 {
@@ -133,9 +161,20 @@ struct UserData10 {
 
 struct ERSaveFile {
     UserData10 userData10;
-    BND4Entry sideCarEnty;
+    // Shared so copies of parsed save don't copy the entry content
+    std::shared_ptr<const BND4Entry> sideCarEnty;
     std::vector<ERCharacterInfo> characters;
 };
 
 ERSaveFile parse_er_file(const SL2File& sl2);
+// Parse only USERDATA_10 entry, slot summaries contain name and level of each character
+UserData10 parse_er_user_data(const SL2File& sl2);
+ERCharacterInfo parse_er_character(const SL2File& sl2, const uint8_t& index);
+
+// Damaged entries are returned as error, offset of the error is in entry content
+ParseResult<ERSaveFile> try_parse_er_file(const SL2File& sl2);
+// Moves entries kept by parsed save out of 'sl2' instead of copying them
+ParseResult<ERSaveFile> try_parse_er_file(SL2File&& sl2);
+ParseResult<UserData10> try_parse_er_user_data(const SL2File& sl2);
+ParseResult<ERCharacterInfo> try_parse_er_character(const SL2File& sl2, const uint8_t& index);
 }
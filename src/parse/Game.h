@@ -1,5 +1,7 @@
 #pragma once
+#include <cctype>
 #include <cstdint>
+#include <string_view>
 
 namespace fssm {
     class Game {
@@ -0,0 +1,11 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fssm::parse {
+    // MD5 digest used by BND4 containers to fingerprint entry data
+    std::array<uint8_t, 16> md5(const uint8_t* data, size_t size);
+    std::string to_hex(const std::array<uint8_t, 16>& digest);
+}
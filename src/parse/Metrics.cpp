@@ -0,0 +1,84 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<fssm::metrics::Counter>> counters;
+    std::map<std::string, std::unique_ptr<fssm::metrics::Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<fssm::metrics::Latency>> latencies;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+template <typename T>
+T& getOrCreate(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& name) {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    auto it = metrics.find(name);
+    if (it == metrics.end()) {
+        it = metrics.emplace(name, std::make_unique<T>()).first;
+    }
+    return *it->second;
+}
+}
+
+namespace fssm::metrics {
+    void Latency::record(uint64_t us) {
+        uint64_t idx = m_count.fetch_add(1, std::memory_order_relaxed);
+        m_samples[idx % WINDOW].store(us, std::memory_order_relaxed);
+        m_last.store(us, std::memory_order_relaxed);
+    }
+
+    void Latency::record(std::chrono::steady_clock::time_point start) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+
+    LatencySummary Latency::summary() const {
+        LatencySummary output;
+        output.count = m_count.load(std::memory_order_relaxed);
+        if (output.count == 0) return output;
+        output.lastMs = static_cast<double>(m_last.load(std::memory_order_relaxed)) / 1000.0;
+
+        size_t filled = static_cast<size_t>(std::min<uint64_t>(output.count, WINDOW));
+        std::vector<uint64_t> samples(filled);
+        for (size_t idx = 0; idx < filled; ++idx) {
+            samples[idx] = m_samples[idx].load(std::memory_order_relaxed);
+        }
+        std::sort(samples.begin(), samples.end());
+        size_t rank = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(filled)));
+        rank = std::clamp<size_t>(rank, 1, filled);
+        output.p95Ms = static_cast<double>(samples[rank - 1]) / 1000.0;
+        return output;
+    }
+
+    Counter& counter(const std::string& name) {
+        return getOrCreate(registry().counters, name);
+    }
+
+    Gauge& gauge(const std::string& name) {
+        return getOrCreate(registry().gauges, name);
+    }
+
+    Latency& latency(const std::string& name) {
+        return getOrCreate(registry().latencies, name);
+    }
+
+    Snapshot snapshot() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        Snapshot output;
+        for (const auto& [name, metric]: reg.counters) output.counters[name] = metric->value();
+        for (const auto& [name, metric]: reg.gauges) output.gauges[name] = metric->value();
+        for (const auto& [name, metric]: reg.latencies) output.latencies[name] = metric->summary();
+        return output;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// App wide registry of named counters, gauges and latencies
+// - metrics are created on first access and live until exit, returned references can be cached
+// - updates are relaxed atomics so they can be done from any thread
+namespace fssm::metrics {
+    class Counter {
+    public:
+        void add(uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+        uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    private:
+        std::atomic<uint64_t> m_value = 0;
+    };
+
+    class Gauge {
+    public:
+        void set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+        int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    private:
+        std::atomic<int64_t> m_value = 0;
+    };
+
+    struct LatencySummary {
+        uint64_t count = 0;
+        double lastMs = 0.0;
+        // Nearest-rank p95 of samples in rolling window
+        double p95Ms = 0.0;
+    };
+
+    // Keeps last 'WINDOW' samples in microseconds
+    class Latency {
+    public:
+        static constexpr size_t WINDOW = 128;
+        void record(uint64_t us);
+        void record(std::chrono::steady_clock::time_point start);
+        LatencySummary summary() const;
+    private:
+        std::array<std::atomic<uint64_t>, WINDOW> m_samples{};
+        std::atomic<uint64_t> m_count = 0;
+        std::atomic<uint64_t> m_last = 0;
+    };
+
+    Counter& counter(const std::string& name);
+    Gauge& gauge(const std::string& name);
+    Latency& latency(const std::string& name);
+
+    struct Snapshot {
+        std::map<std::string, uint64_t> counters;
+        std::map<std::string, int64_t> gauges;
+        std::map<std::string, LatencySummary> latencies;
+    };
+    Snapshot snapshot();
+}
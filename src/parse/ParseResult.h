@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace fssm::parse {
+    enum class ParseErrorCode: uint8_t {
+        FileError,
+        FileTooSmall,
+        BadMagic,
+        InvalidHeader,
+        OutOfBounds,
+        InvalidEntry,
+        MissingEntries,
+        InvalidValue,
+        Unknown,
+    };
+
+    constexpr const char* to_string(ParseErrorCode code) {
+        switch (code) {
+            case ParseErrorCode::FileError: return "file_error";
+            case ParseErrorCode::FileTooSmall: return "file_too_small";
+            case ParseErrorCode::BadMagic: return "bad_magic";
+            case ParseErrorCode::InvalidHeader: return "invalid_header";
+            case ParseErrorCode::OutOfBounds: return "out_of_bounds";
+            case ParseErrorCode::InvalidEntry: return "invalid_entry";
+            case ParseErrorCode::MissingEntries: return "missing_entries";
+            case ParseErrorCode::InvalidValue: return "invalid_value";
+            default: return "unknown";
+        }
+    }
+
+    struct ParseError {
+        ParseErrorCode code{ParseErrorCode::Unknown};
+        // Offset in file for container errors, in entry content for game parser errors (see message)
+        // - negative if not known
+        int64_t offset{-1};
+        std::string message;
+
+        std::string toString() const {
+            if (offset < 0) return message;
+            return message + " (offset " + std::to_string(offset) + ")";
+        }
+    };
+
+    // Thrown by throwing parse functions, derives from 'std::runtime_error' so existing handlers keep working
+    class ParseException: public std::runtime_error {
+    public:
+        explicit ParseException(ParseError error)
+            : std::runtime_error(error.toString()), m_error(std::move(error)) {}
+        ParseException(ParseErrorCode code, int64_t offset, const std::string& message)
+            : ParseException(ParseError{code, offset, message}) {}
+        const ParseError& error() const { return m_error; }
+    private:
+        ParseError m_error;
+    };
+
+    // Value or error returned by 'try_*' parse functions
+    // - damaged input is returned as error instead of exception, 'value()' throws 'ParseException' on error
+    template <typename T>
+    class ParseResult {
+    public:
+        // Separate overloads so returned local values are moved in C++17
+        ParseResult(const T& value): m_data(std::in_place_index<0>, value) {}
+        ParseResult(T&& value): m_data(std::in_place_index<0>, std::move(value)) {}
+        ParseResult(const ParseError& error): m_data(std::in_place_index<1>, error) {}
+        ParseResult(ParseError&& error): m_data(std::in_place_index<1>, std::move(error)) {}
+
+        bool ok() const { return m_data.index() == 0; }
+        explicit operator bool() const { return ok(); }
+
+        const T& value() const & { check(); return std::get<0>(m_data); }
+        T& value() & { check(); return std::get<0>(m_data); }
+        T&& value() && { check(); return std::get<0>(std::move(m_data)); }
+        const ParseError& error() const { return std::get<1>(m_data); }
+
+    private:
+        void check() const {
+            if (!ok()) throw ParseException(error());
+        }
+        std::variant<T, ParseError> m_data;
+    };
+
+    // Run throwing parse function and return its exception as error
+    // - used by 'try_*' functions of game parsers where errors can only be found while reading
+    template <typename Func>
+    auto catch_parse_error(Func&& func) -> ParseResult<decltype(func())> {
+        try {
+            return func();
+        } catch (const ParseException& e) {
+            return e.error();
+        } catch (const std::exception& e) {
+            return ParseError{ParseErrorCode::Unknown, -1, e.what()};
+        }
+    }
+}
@@ -1,16 +1,20 @@
 #include "SL2File.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <optional>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <cstring>
-#include <iostream>
-#include <locale>
 
 #include "aes.hpp"
 
 #include "Game.h"
+#include "Md5.h"
+#include "Metrics.h"
+#include "Trace.h"
 #include "Utils.h"
 
 
@@ -42,10 +46,16 @@ static Game detect_game(const BND4Header& header, const std::vector<uint8_t>& co
 }
 
 
-static std::vector<uint8_t> decrypt_entry(
+// Decrypt entry in place, result is data without IV and length prefix
+static std::optional<ParseError> decrypt_entry(
     std::vector<uint8_t>& entry_content,
-    const unsigned char* key
+    const unsigned char* key,
+    uint64_t offset
 ) {
+    // IV and at least one whole AES block
+    if (entry_content.size() < 32 || entry_content.size() % 16 != 0) {
+        return ParseError{ParseErrorCode::InvalidEntry, static_cast<int64_t>(offset), "Invalid size of encrypted entry"};
+    }
     std::vector<uint8_t> iv;
     iv.assign(entry_content.begin(), entry_content.begin() + 16);
 
@@ -55,48 +65,190 @@ static std::vector<uint8_t> decrypt_entry(
 
     // Result buffer layout now: [0:16]=out_iv, [16:20]=len, [20:]=data (possibly padded)
     const uint8_t* dec = entry_content.data();
-    int len = read_u32_le(dec + 16);
+    uint32_t len = read_u32_le(dec + 16);
+    if (len > entry_content.size() - 20) {
+        return ParseError{ParseErrorCode::InvalidEntry, static_cast<int64_t>(offset), "Decrypted entry length out of bounds"};
+    }
     entry_content.erase(entry_content.begin(), entry_content.begin() + 20);
     entry_content.resize(len);
-    return entry_content;
+    return std::nullopt;
 }
 
-std::vector<uint8_t> decrypt_entry_content(
+// Decrypt raw entry data (without checksum) in place, 'offset' is used only for errors
+static std::optional<ParseError> decrypt_entry_content(
+    std::vector<uint8_t>& entry_content,
+    uint64_t offset,
+    const Game game
+) {
+    const unsigned char* key = nullptr;
+    switch (game) {
+        case Game::DSR: key = DSR_KEY; break;
+        case Game::DS2_SOTFS: key = DS2_KEY; break;
+        case Game::DS3: key = DS3_KEY; break;
+        default: return std::nullopt;
+    }
+    return decrypt_entry(entry_content, key, offset);
+}
+
+static std::vector<uint8_t> encrypt_entry(
     const std::vector<uint8_t>& content,
-    const BND4EntryHeader& header,
+    const std::array<uint8_t, 16>& iv,
+    const unsigned char* key
+) {
+    // Inverse of 'decrypt_entry', plain data are [0:4]=len, [4:]=data padded to AES block size
+    size_t plainSize = (4 + content.size() + 15) / 16 * 16;
+    std::vector<uint8_t> output(16 + plainSize, 0);
+    std::memcpy(output.data(), iv.data(), iv.size());
+    write_u32_le(output.data() + 16, static_cast<uint32_t>(content.size()));
+    if (!content.empty()) std::memcpy(output.data() + 20, content.data(), content.size());
+
+    AES_ctx ctx; AES_init_ctx_iv(&ctx, key, iv.data());
+    AES_CBC_encrypt_buffer(&ctx, output.data() + 16, plainSize);
+    return output;
+}
+
+std::vector<uint8_t> encrypt_entry_content(
+    const std::vector<uint8_t>& content,
+    const std::array<uint8_t, 16>& iv,
     const Game game
 ) {
-    uint32_t ds = header.entry_data_offset;
-    uint32_t de = ds + header.entry_size;
-    std::vector<uint8_t> checksum;
-    std::vector<uint8_t> entry_content;
-    checksum.reserve(16);
-    checksum.assign(content.begin() + ds, content.begin() + ds + 16);
-    entry_content.assign(content.begin() + ds + 16, content.begin() + de);
     switch (game) {
-        case Game::DSR: return decrypt_entry(entry_content, DSR_KEY);
-        case Game::DS2_SOTFS: return decrypt_entry(entry_content, DS2_KEY);
-        case Game::DS3: return decrypt_entry(entry_content, DS3_KEY);
-        default: return entry_content;
+        case Game::DSR: return encrypt_entry(content, iv, DSR_KEY);
+        case Game::DS2_SOTFS: return encrypt_entry(content, iv, DS2_KEY);
+        case Game::DS3: return encrypt_entry(content, iv, DS3_KEY);
+        default: return content;
     }
 }
 
-SL2File parse_sl2_file(const std::string& input_sl2_file) {
-    std::ifstream f(input_sl2_file, std::ios::binary);
-    if (!f) throw std::runtime_error("Failed to open file");
-    std::vector<uint8_t> content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
-    f.close();
+static ParseResult<std::vector<uint8_t>> read_file_content(const std::string& input_sl2_file) {
+    FSSM_TRACE_SCOPE("sl2.read_file");
+    std::ifstream f(input_sl2_file, std::ios::binary | std::ios::ate);
+    if (!f) return ParseError{ParseErrorCode::FileError, -1, "Failed to open file"};
+    const std::streamoff size = f.tellg();
+    if (size < 0) return ParseError{ParseErrorCode::FileError, -1, "Failed to read file"};
+    // One sized read, reading through stream iterators is several times slower
+    std::vector<uint8_t> content(static_cast<size_t>(size));
+    f.seekg(0);
+    f.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(size));
+    if (f.gcount() != size) return ParseError{ParseErrorCode::FileError, -1, "Failed to read file"};
+    return content;
+}
+
+// Container bytes are read through source, file source reads only headers and requested entries
+class ContainerSource {
+public:
+    virtual ~ContainerSource() = default;
+    virtual uint64_t size() const = 0;
+    // Copy 'size' bytes from 'offset' to 'output', range must be validated against 'size()'
+    virtual bool read(uint64_t offset, uint8_t* output, size_t size) = 0;
+};
 
-    if (content.size() < 64) {
-        throw std::runtime_error("File too small to be a valid BND4 container");
+class MemorySource: public ContainerSource {
+public:
+    explicit MemorySource(const std::vector<uint8_t>& content): m_content(content) {}
+    uint64_t size() const override { return m_content.size(); }
+    bool read(uint64_t offset, uint8_t* output, size_t size) override {
+        if (size > 0) std::memcpy(output, m_content.data() + offset, size);
+        return true;
     }
+private:
+    const std::vector<uint8_t>& m_content;
+};
 
-    const uint8_t* data = content.data();
+class FileSource: public ContainerSource {
+public:
+    explicit FileSource(const std::string& path): m_file(path, std::ios::binary | std::ios::ate) {
+        if (!m_file) return;
+        const std::streamoff size = m_file.tellg();
+        if (size < 0) {
+            m_file.setstate(std::ios::failbit);
+            return;
+        }
+        m_size = static_cast<uint64_t>(size);
+    }
+    bool isOpen() const { return static_cast<bool>(m_file); }
+    uint64_t size() const override { return m_size; }
+    bool read(uint64_t offset, uint8_t* output, size_t size) override {
+        m_file.seekg(static_cast<std::streamoff>(offset));
+        m_file.read(reinterpret_cast<char*>(output), static_cast<std::streamsize>(size));
+        return m_file && static_cast<size_t>(m_file.gcount()) == size;
+    }
+private:
+    std::ifstream m_file;
+    uint64_t m_size = 0;
+};
 
-    // Check magic "BND4"
-    if (!(data[0] == 'B' && data[1] == 'N' && data[2] == 'D' && data[3] == '4')) {
-        throw std::runtime_error("Expected header 'BND4'");
+// Supported containers have at most 23 entries (DS2), larger count means corrupted header
+constexpr uint32_t MAX_FILES_COUNT = 64;
+constexpr uint64_t ENTRY_NAME_SIZE = 26;
+
+// 'content' contains at least first 64 bytes of file of 'size' bytes
+static std::optional<ParseError> validate_header(const std::vector<uint8_t>& content, uint64_t size) {
+    if (size < 64 || content.size() < 64) {
+        return ParseError{ParseErrorCode::FileTooSmall, 0, "File too small to be a valid BND4 container"};
+    }
+    if (!(content[0] == 'B' && content[1] == 'N' && content[2] == 'D' && content[3] == '4')) {
+        return ParseError{ParseErrorCode::BadMagic, 0, "Expected header 'BND4'"};
+    }
+    return std::nullopt;
+}
+
+static std::optional<ParseError> validate_entry_headers(const BND4Header& header, uint64_t size) {
+    if (header.files_count > MAX_FILES_COUNT) {
+        return ParseError{
+            ParseErrorCode::InvalidHeader, 12, "Invalid entries count " + std::to_string(header.files_count)
+        };
+    }
+    if (64 + static_cast<uint64_t>(header.files_count) * 32 > size) {
+        return ParseError{ParseErrorCode::OutOfBounds, 64, "Entry headers out of file bounds"};
+    }
+    return std::nullopt;
+}
+
+// Check offsets of all entries once so entries can be copied without further checks
+// - 'content' contains header and entry headers of file of 'size' bytes
+static std::optional<ParseError> validate_container(
+    const std::vector<uint8_t>& content,
+    uint64_t size,
+    const BND4Header& header
+) {
+    for (uint32_t idx = 0; idx < header.files_count; ++idx) {
+        const int64_t headerOffset = 64 + idx * 32;
+        const uint8_t* hp = content.data() + headerOffset;
+        uint64_t entrySize = read_u64_le(hp + 8);
+        uint64_t dataOffset = read_u32_le(hp + 16);
+        uint64_t nameOffset = read_u32_le(hp + 20);
+        if (nameOffset + ENTRY_NAME_SIZE > size) {
+            return ParseError{
+                ParseErrorCode::OutOfBounds, headerOffset + 20,
+                "Name of entry " + std::to_string(idx) + " out of file bounds"
+            };
+        }
+        // Entry data start with 16 bytes of MD5 checksum
+        if (entrySize < 16 || entrySize > size || dataOffset > size - entrySize) {
+            return ParseError{
+                ParseErrorCode::OutOfBounds, headerOffset + 8,
+                "Data of entry " + std::to_string(idx) + " out of file bounds"
+            };
+        }
     }
+    return std::nullopt;
+}
+
+static ParseResult<SL2File> parse_sl2_content(
+    ContainerSource& source,
+    const std::string& input_sl2_file,
+    const std::vector<uint32_t>* entryIndexes
+) {
+    FSSM_TRACE_SCOPE("sl2.parse_container");
+    const uint64_t size = source.size();
+    const ParseError readError{ParseErrorCode::FileError, -1, "Failed to read file"};
+    // Header with entry headers, entry data are read only for requested entries
+    std::vector<uint8_t> content(size < 64 ? 0 : 64);
+    if (!source.read(0, content.data(), content.size())) return readError;
+    if (auto error = validate_header(content, size)) return *error;
+
+    const uint8_t* data = content.data();
 
     // Unpack <QIQQQQ? from bytes [4:49)
     BND4Header header{};
@@ -108,9 +260,12 @@ SL2File parse_sl2_file(const std::string& input_sl2_file) {
     header.entry_header_size = read_u64_le(data + 32);
     header.data_offset = read_u64_le(data + 40);
     header.is_utf16 = (*(data + 48)) != 0;
-    if (content.size() >= 64) {
-        std::memcpy(header.unknown_3.data(), data + 49, 15);
-    }
+    std::memcpy(header.unknown_3.data(), data + 49, 15);
+    if (auto error = validate_entry_headers(header, size)) return *error;
+    content.resize(64 + header.files_count * 32);
+    if (!source.read(64, content.data() + 64, content.size() - 64)) return readError;
+    data = content.data();
+    if (auto error = validate_container(content, size, header)) return *error;
 
     SL2File sl2;
     sl2.header = header;
@@ -121,9 +276,7 @@ SL2File parse_sl2_file(const std::string& input_sl2_file) {
     sl2.entries.reserve(header.files_count);
     const bool utf16 = header.is_utf16;
     for (uint32_t idx = 0; idx < header.files_count; ++idx) {
-        int hs = 64 + static_cast<int>(idx) * 32;
-        if (static_cast<int>(content.size()) < hs + 32) break;
-        const uint8_t* hp = data + hs;
+        const uint8_t* hp = data + 64 + idx * 32;
         BND4EntryHeader eh{};
         eh.padding = read_u64_le(hp + 0);
         eh.entry_size = read_u64_le(hp + 8);
@@ -131,19 +284,16 @@ SL2File parse_sl2_file(const std::string& input_sl2_file) {
         eh.entry_name_offset = read_u32_le(hp + 20);
         eh.entry_footer_length = read_u64_le(hp + 24);
 
-        int ns = static_cast<int>(eh.entry_name_offset);
-        std::vector<uint8_t> name_b;
         // TODO use u16 string all the time
         std::string name;
-        name_b.assign(content.begin() + ns, content.begin() + ns + 26);
+        std::vector<uint8_t> name_b(ENTRY_NAME_SIZE);
+        if (!source.read(eh.entry_name_offset, name_b.data(), name_b.size())) return readError;
         if (utf16) {
-            std::u16string name_u16;
-            for (size_t i = 0; i + 1 < name_b.size(); i += 2) {
-                char16_t ch = static_cast<char16_t>(name_b[i] | (static_cast<uint16_t>(name_b[i + 1]) << 8));
-                if (ch == 0) break;
-                name_u16.push_back(ch);
-            }
-            name = utf16_to_utf8(name_u16);
+            char16_t name_u16[13];
+            char name_u8[13 * 3];
+            size_t name_len = u16_strnlen(name_b.data(), 13);
+            read_u16_units(name_b.data(), name_len, name_u16);
+            name.assign(name_u8, utf16_to_utf8(name_u16, name_len, name_u8));
         } else {
             for (char c: name_b) {
                 if (c == 0) break;
@@ -151,11 +301,199 @@ SL2File parse_sl2_file(const std::string& input_sl2_file) {
             }
         }
 
-        // Copy raw content of the entry (still encrypted for some games)
-        std::vector<uint8_t> entry_content = decrypt_entry_content(content, eh, sl2.game);
-        sl2.entries.push_back(BND4Entry{eh, std::move(name_b), std::move(name), std::move(entry_content)});
+        std::array<uint8_t, 16> checksum{};
+        if (!source.read(eh.entry_data_offset, checksum.data(), checksum.size())) return readError;
+
+        // Offsets were validated by 'validate_container', data follow the checksum
+        std::vector<uint8_t> entry_content;
+        if (
+            entryIndexes == nullptr
+            || std::find(entryIndexes->begin(), entryIndexes->end(), idx) != entryIndexes->end()
+        ) {
+            const uint64_t contentOffset = static_cast<uint64_t>(eh.entry_data_offset) + checksum.size();
+            entry_content.resize(static_cast<size_t>(eh.entry_size) - checksum.size());
+            {
+                FSSM_TRACE_SCOPE_ARG("sl2.read_entry", idx);
+                if (!source.read(contentOffset, entry_content.data(), entry_content.size())) return readError;
+            }
+            FSSM_TRACE_SCOPE_ARG("sl2.decrypt_entry", idx);
+            if (auto error = decrypt_entry_content(entry_content, contentOffset, sl2.game)) return *error;
+        }
+        sl2.entries.push_back(BND4Entry{eh, std::move(name_b), std::move(name), std::move(entry_content), checksum});
     }
 
     return sl2;
 }
+
+static ParseResult<SL2File> load_sl2_file(const std::string& input_sl2_file, const std::vector<uint32_t>* entryIndexes) {
+    auto start = std::chrono::steady_clock::now();
+    // Whole file is never loaded to memory, only headers and requested entries are read
+    FileSource source(input_sl2_file);
+    if (!source.isOpen()) return ParseError{ParseErrorCode::FileError, -1, "Failed to open file"};
+    ParseResult<SL2File> sl2 = parse_sl2_content(source, input_sl2_file, entryIndexes);
+    if (sl2) metrics::latency(std::string("load.") + sl2.value().game.toString()).record(start);
+    return sl2;
+}
+
+ParseResult<SL2File> try_parse_sl2_content(const std::vector<uint8_t>& content, const std::string& input_sl2_file) {
+    MemorySource source(content);
+    return parse_sl2_content(source, input_sl2_file, nullptr);
+}
+
+ParseResult<SL2File> try_parse_sl2_file(const std::string& input_sl2_file) {
+    return load_sl2_file(input_sl2_file, nullptr);
+}
+
+ParseResult<SL2File> try_parse_sl2_file(const std::string& input_sl2_file, const std::vector<uint32_t>& entryIndexes) {
+    return load_sl2_file(input_sl2_file, &entryIndexes);
+}
+
+ParseResult<Game> try_detect_sl2_game(const std::string& input_sl2_file) {
+    // Header and first entry header are enough to detect the game
+    std::ifstream f(input_sl2_file, std::ios::binary);
+    if (!f) return ParseError{ParseErrorCode::FileError, -1, "Failed to open file"};
+    std::vector<uint8_t> content(64 + 32);
+    f.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<size_t>(f.gcount()));
+    if (auto error = validate_header(content, content.size())) return *error;
+    BND4Header header{};
+    header.files_count = read_u32_le(content.data() + 12);
+    return detect_game(header, content);
+}
+
+ParseResult<std::vector<BND4EntryChecksum>> try_verify_sl2_checksums(const std::string& input_sl2_file) {
+    ParseResult<std::vector<uint8_t>> contentResult = read_file_content(input_sl2_file);
+    if (!contentResult) return contentResult.error();
+    const std::vector<uint8_t>& content = contentResult.value();
+    // Only headers are needed, content of entries is not decrypted
+    const std::vector<uint32_t> noEntries;
+    MemorySource source(content);
+    ParseResult<SL2File> sl2 = parse_sl2_content(source, input_sl2_file, &noEntries);
+    if (!sl2) return sl2.error();
+
+    // Entry bounds were validated by 'parse_sl2_content'
+    std::vector<BND4EntryChecksum> output;
+    output.reserve(sl2.value().entries.size());
+    for (uint32_t idx = 0; idx < sl2.value().entries.size(); ++idx) {
+        const BND4Entry& entry = sl2.value().entries[idx];
+        uint64_t start = static_cast<uint64_t>(entry.header.entry_data_offset) + entry.checksum.size();
+        uint64_t end = static_cast<uint64_t>(entry.header.entry_data_offset) + entry.header.entry_size;
+        output.push_back(BND4EntryChecksum{
+            idx,
+            entry.name,
+            entry.checksum,
+            md5(content.data() + start, static_cast<size_t>(end - start)),
+        });
+    }
+    return output;
+}
+
+SL2File parse_sl2_content(const std::vector<uint8_t>& content, const std::string& input_sl2_file) {
+    return try_parse_sl2_content(content, input_sl2_file).value();
+}
+
+SL2File parse_sl2_file(const std::string& input_sl2_file) {
+    return try_parse_sl2_file(input_sl2_file).value();
+}
+
+SL2File parse_sl2_file(const std::string& input_sl2_file, const std::vector<uint32_t>& entryIndexes) {
+    return try_parse_sl2_file(input_sl2_file, entryIndexes).value();
+}
+
+Game detect_sl2_game(const std::string& input_sl2_file) {
+    return try_detect_sl2_game(input_sl2_file).value();
+}
+
+std::vector<BND4EntryChecksum> verify_sl2_checksums(const std::string& input_sl2_file) {
+    return try_verify_sl2_checksums(input_sl2_file).value();
+}
+}
+
+namespace fssm::parse {
+static size_t align_16(size_t value) {
+    return (value + 15) / 16 * 16;
+}
+
+std::vector<uint8_t> build_sl2_content(SL2File& sl2) {
+    const size_t filesCount = sl2.entries.size();
+    const size_t nameSize = 26;
+    const size_t namesOffset = 64 + filesCount * 32;
+    const size_t dataOffset = align_16(namesOffset + filesCount * nameSize);
+
+    // Encrypt entries first to know their sizes
+    std::vector<std::vector<uint8_t>> entriesData;
+    entriesData.reserve(filesCount);
+    for (uint32_t idx = 0; idx < filesCount; ++idx) {
+        BND4Entry& entry = sl2.entries[idx];
+        // IV is derived from entry content so the output is reproducible
+        std::array<uint8_t, 16> iv = md5(entry.content.data(), entry.content.size());
+        iv[15] ^= static_cast<uint8_t>(idx);
+        std::vector<uint8_t> data = encrypt_entry_content(entry.content, iv, sl2.game);
+        entry.checksum = md5(data.data(), data.size());
+        entriesData.push_back(std::move(data));
+    }
+
+    size_t totalSize = dataOffset;
+    for (const auto& data: entriesData) {
+        totalSize = align_16(totalSize + 16 + data.size());
+    }
+
+    std::vector<uint8_t> output(totalSize, 0);
+    uint8_t* out = output.data();
+    sl2.header.bnd_vers = {'B', 'N', 'D', '4'};
+    sl2.header.files_count = static_cast<uint32_t>(filesCount);
+    sl2.header.entry_header_size = 32;
+    sl2.header.data_offset = dataOffset;
+    sl2.header.is_utf16 = true;
+    std::memcpy(out, sl2.header.bnd_vers.data(), 4);
+    write_u64_le(out + 4, sl2.header.unknown_1);
+    write_u32_le(out + 12, sl2.header.files_count);
+    write_u64_le(out + 16, sl2.header.unknown_2);
+    write_u64_le(out + 24, sl2.header.sig);
+    write_u64_le(out + 32, sl2.header.entry_header_size);
+    write_u64_le(out + 40, sl2.header.data_offset);
+    out[48] = 1;
+    std::memcpy(out + 49, sl2.header.unknown_3.data(), sl2.header.unknown_3.size());
+
+    size_t offset = dataOffset;
+    for (uint32_t idx = 0; idx < filesCount; ++idx) {
+        BND4Entry& entry = sl2.entries[idx];
+        const std::vector<uint8_t>& data = entriesData[idx];
+        if (offset > 0xFFFFFFFFu) throw std::length_error("Container too large");
+        entry.header.entry_size = 16 + data.size();
+        entry.header.entry_data_offset = static_cast<uint32_t>(offset);
+        entry.header.entry_name_offset = static_cast<uint32_t>(namesOffset + idx * nameSize);
+
+        uint8_t* hp = out + 64 + idx * 32;
+        write_u64_le(hp + 0, entry.header.padding);
+        write_u64_le(hp + 8, entry.header.entry_size);
+        write_u32_le(hp + 16, entry.header.entry_data_offset);
+        write_u32_le(hp + 20, entry.header.entry_name_offset);
+        write_u64_le(hp + 24, entry.header.entry_footer_length);
+
+        // Names are stored as UTF-16, raw bytes are reused if available
+        uint8_t* np = out + entry.header.entry_name_offset;
+        if (!entry.name_b.empty()) {
+            std::memcpy(np, entry.name_b.data(), std::min(entry.name_b.size(), nameSize));
+        } else {
+            for (size_t i = 0; i < entry.name.size() && (i + 1) * 2 < nameSize; ++i) {
+                np[i * 2] = static_cast<uint8_t>(entry.name[i]);
+            }
+        }
+
+        std::memcpy(out + offset, entry.checksum.data(), entry.checksum.size());
+        std::memcpy(out + offset + 16, data.data(), data.size());
+        offset = align_16(offset + 16 + data.size());
+    }
+    return output;
+}
+
+void write_sl2_file(SL2File& sl2, const std::string& output_sl2_file) {
+    std::vector<uint8_t> content = build_sl2_content(sl2);
+    std::ofstream f(output_sl2_file, std::ios::binary | std::ios::trunc);
+    if (!f) throw std::runtime_error("Failed to open file for writing");
+    f.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    if (!f) throw std::runtime_error("Failed to write file");
+    sl2.filepath = output_sl2_file;
+}
 }
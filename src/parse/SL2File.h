@@ -5,6 +5,7 @@
 #include <array>
 
 #include "Game.h"
+#include "ParseResult.h"
 
 namespace fssm::parse {
     struct BND4Header {
@@ -33,6 +34,7 @@ namespace fssm::parse {
         std::vector<uint8_t> name_b;
         std::string name;
         std::vector<uint8_t> content;  // raw content (still encrypted for some games)
+        std::array<uint8_t, 16> checksum{};  // MD5 stored in front of entry data, used as fingerprint
     };
 
     struct SL2File {
@@ -43,6 +45,42 @@ namespace fssm::parse {
     };
 
 
+    struct BND4EntryChecksum {
+        uint32_t index{};
+        std::string name;
+        std::array<uint8_t, 16> stored{};
+        std::array<uint8_t, 16> computed{};
+
+        bool isValid() const { return stored == computed; }
+    };
+
     // Parse the .sl2 container and detect the game. Does not decrypt inner files yet.
+    // - throwing functions below are wrappers of 'try_*' functions and throw 'ParseException'
     SL2File parse_sl2_file(const std::string& input_sl2_file);
+    // Same as above but only content of entries with passed indexes is loaded, other entries have empty content
+    SL2File parse_sl2_file(const std::string& input_sl2_file, const std::vector<uint32_t>& entryIndexes);
+    // Parse container already loaded in memory, 'input_sl2_file' is only stored to 'filepath'
+    SL2File parse_sl2_content(const std::vector<uint8_t>& content, const std::string& input_sl2_file = "");
+    // Detect game from container header without reading whole file
+    Game detect_sl2_game(const std::string& input_sl2_file);
+
+    // Non-throwing variants, damaged files are returned as error with offset in file
+    // - entry offsets are validated up front so scanning many files does not pay for exceptions
+    ParseResult<SL2File> try_parse_sl2_file(const std::string& input_sl2_file);
+    ParseResult<SL2File> try_parse_sl2_file(const std::string& input_sl2_file, const std::vector<uint32_t>& entryIndexes);
+    ParseResult<SL2File> try_parse_sl2_content(const std::vector<uint8_t>& content, const std::string& input_sl2_file = "");
+    ParseResult<Game> try_detect_sl2_game(const std::string& input_sl2_file);
+
+    // Encrypt decrypted entry content for games with encrypted entries, result starts with 'iv'
+    std::vector<uint8_t> encrypt_entry_content(
+        const std::vector<uint8_t>& content,
+        const std::array<uint8_t, 16>& iv,
+        Game game
+    );
+    // Build .sl2 container from entries with decrypted content, entry headers and checksums are updated
+    std::vector<uint8_t> build_sl2_content(SL2File& sl2);
+    void write_sl2_file(SL2File& sl2, const std::string& output_sl2_file);
+    // Compare MD5 stored in front of each entry with MD5 of the entry data
+    std::vector<BND4EntryChecksum> verify_sl2_checksums(const std::string& input_sl2_file);
+    ParseResult<std::vector<BND4EntryChecksum>> try_verify_sl2_checksums(const std::string& input_sl2_file);
 }
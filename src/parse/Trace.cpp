@@ -0,0 +1,157 @@
+#include "Trace.h"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+struct Event {
+    const char* name;
+    int64_t arg;
+    uint64_t start;
+    uint64_t end;
+};
+
+// Events are appended only by owning thread, 'count' is published after event is written
+// so writer can read chunks while the thread keeps recording
+constexpr size_t CHUNK_EVENTS = 4096;
+// Per-thread limit (~32MB), spans above the limit are only counted
+constexpr size_t MAX_CHUNKS = 256;
+
+struct Chunk {
+    std::array<Event, CHUNK_EVENTS> events;
+    std::atomic<size_t> count = 0;
+    std::atomic<Chunk*> next = nullptr;
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(uint32_t tid): tid(tid), head(new Chunk()), tail(head) {}
+    ~ThreadBuffer() {
+        Chunk* chunk = head;
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+    uint32_t tid;
+    Chunk* head;
+    // Touched only by owning thread
+    Chunk* tail;
+    size_t chunks = 1;
+    std::atomic<uint64_t> dropped = 0;
+};
+
+// Buffers are kept after their thread ends so its spans are still written
+std::mutex g_registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+const std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+
+ThreadBuffer& thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        buffer = std::make_shared<ThreadBuffer>(static_cast<uint32_t>(g_buffers.size() + 1));
+        g_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void write_escaped(std::ostream& o, const char* value) {
+    for (const char* c = value; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') o << '\\';
+        o << *c;
+    }
+}
+}
+
+namespace fssm::trace {
+    void set_enabled(bool enabled) {
+        detail::g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::string init_from_environment() {
+        const char* value = std::getenv("FSSM_TRACE");
+        if (value == nullptr || value[0] == '\0') return "";
+        set_enabled(true);
+        return value;
+    }
+
+    uint64_t now_ns() {
+        // Offset by one so valid timestamp is never 0
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_start).count()
+        ) + 1;
+    }
+
+    void record_span(const char* name, int64_t arg, uint64_t startNs, uint64_t endNs) {
+        ThreadBuffer& buffer = thread_buffer();
+        Chunk* chunk = buffer.tail;
+        size_t count = chunk->count.load(std::memory_order_relaxed);
+        if (count == CHUNK_EVENTS) {
+            if (buffer.chunks == MAX_CHUNKS) {
+                buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Chunk* next = new Chunk();
+            chunk->next.store(next, std::memory_order_release);
+            buffer.tail = next;
+            buffer.chunks++;
+            chunk = next;
+            count = 0;
+        }
+        chunk->events[count] = Event{name, arg, startNs, endNs};
+        chunk->count.store(count + 1, std::memory_order_release);
+    }
+
+    uint64_t span_count() {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        uint64_t output = 0;
+        for (const auto& buffer: g_buffers) {
+            for (Chunk* chunk = buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+                output += chunk->count.load(std::memory_order_acquire);
+            }
+        }
+        return output;
+    }
+
+    bool write_trace(const std::string& path) {
+        std::ofstream o(path, std::ios::trunc);
+        if (!o) return false;
+        o << std::fixed << std::setprecision(3);
+        o << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        o << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"FromSoftSaveManager\"}}";
+
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        for (const auto& buffer: g_buffers) {
+            o << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+            uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+            if (dropped > 0) {
+                o << ",\n{\"name\":\"dropped_spans\",\"ph\":\"C\",\"pid\":1,\"tid\":" << buffer->tid
+                    << ",\"ts\":0,\"args\":{\"count\":" << dropped << "}}";
+            }
+            for (Chunk* chunk = buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+                size_t count = chunk->count.load(std::memory_order_acquire);
+                for (size_t idx = 0; idx < count; ++idx) {
+                    const Event& event = chunk->events[idx];
+                    // Chrome trace timestamps are in microseconds
+                    o << ",\n{\"name\":\"";
+                    write_escaped(o, event.name);
+                    o << "\",\"cat\":\"fssm\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                        << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                        << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0;
+                    if (event.arg >= 0) o << ",\"args\":{\"index\":" << event.arg << "}";
+                    o << "}";
+                }
+            }
+        }
+        o << "\n]}\n";
+        return static_cast<bool>(o);
+    }
+}
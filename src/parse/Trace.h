@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped spans written as Chrome trace JSON (chrome://tracing, https://ui.perfetto.dev)
+// - compiled out unless 'FSSM_TRACING' is defined, recorded only when enabled at runtime
+// - each thread appends to its own buffer without locks, buffers are read on 'write_trace'
+namespace fssm::trace {
+    namespace detail {
+        inline std::atomic<bool> g_enabled = false;
+    }
+
+    inline bool is_enabled() {
+        return detail::g_enabled.load(std::memory_order_relaxed);
+    }
+    void set_enabled(bool enabled);
+
+    // Enable tracing if 'FSSM_TRACE' environment variable is set, its value is path to trace file
+    // - returns the path or empty string
+    std::string init_from_environment();
+
+    // Write spans recorded by all threads so far, can be called repeatedly
+    bool write_trace(const std::string& path);
+    uint64_t span_count();
+
+    uint64_t now_ns();
+    void record_span(const char* name, int64_t arg, uint64_t startNs, uint64_t endNs);
+
+    // 'name' must be string literal, 'arg' is shown in span args if not negative (e.g. entry index)
+    class Span {
+    public:
+        explicit Span(const char* name, int64_t arg = -1):
+            m_name(name), m_arg(arg), m_start(is_enabled() ? now_ns() : 0) {}
+        ~Span() {
+            if (m_start != 0) record_span(m_name, m_arg, m_start, now_ns());
+        }
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    private:
+        const char* m_name;
+        int64_t m_arg;
+        uint64_t m_start;
+    };
+}
+
+#ifdef FSSM_TRACING
+#define FSSM_TRACE_CONCAT_INNER(a, b) a##b
+#define FSSM_TRACE_CONCAT(a, b) FSSM_TRACE_CONCAT_INNER(a, b)
+#define FSSM_TRACE_SCOPE(name) ::fssm::trace::Span FSSM_TRACE_CONCAT(fssmTraceSpan, __LINE__)(name)
+#define FSSM_TRACE_SCOPE_ARG(name, arg) ::fssm::trace::Span FSSM_TRACE_CONCAT(fssmTraceSpan, __LINE__)(name, static_cast<int64_t>(arg))
+#else
+#define FSSM_TRACE_SCOPE(name) ((void)0)
+#define FSSM_TRACE_SCOPE_ARG(name, arg) ((void)0)
+#endif
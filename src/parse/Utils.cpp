@@ -1,9 +1,12 @@
-#include <codecvt>
 #include <cstdint>
 #include <cstring>
-#include <locale>
 #include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define FSSM_HAS_SSE2 1
+#endif
+
 #include "Utils.h"
 
 namespace fssm::parse {
@@ -38,20 +41,101 @@ namespace fssm::parse {
         return v;
     }
 
-    std::string utf16_to_utf8(const std::u16string& s)
-    {
-        // Note: deprecated in C++17, removed in some lib std builds; still widely available.
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
-        return conv.to_bytes(s);
+    void write_u16_le(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void write_u32_le(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    void write_u64_le(uint8_t* p, uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    size_t u16_strnlen(const uint8_t* p, size_t maxUnits) {
+        size_t i = 0;
+#ifdef FSSM_HAS_SSE2
+        // Compare 8 code units per iteration, byte order does not matter for a zero test
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= maxUnits; i += 8) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * i));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, zero));
+            if (mask != 0) return i + (__builtin_ctz(static_cast<unsigned>(mask)) >> 1);
+        }
+#endif
+        for (; i < maxUnits; ++i) {
+            if (p[2 * i] == 0 && p[2 * i + 1] == 0) return i;
+        }
+        return maxUnits;
+    }
+
+    size_t utf16_to_utf8(const char16_t* src, size_t len, char* dst) {
+        char* out = dst;
+        size_t i = 0;
+        while (i < len) {
+#ifdef FSSM_HAS_SSE2
+            // ASCII fast path, narrow 8 code units at once while all of them are < 0x80
+            if (i + 8 <= len) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i high = _mm_and_si128(chunk, _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(chunk, chunk));
+                    out += 8;
+                    i += 8;
+                    continue;
+                }
+            }
+#endif
+            uint32_t cp = src[i++];
+            if (cp < 0x80) {
+                *out++ = static_cast<char>(cp);
+                continue;
+            }
+            if (cp < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (cp >> 6));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                continue;
+            }
+            if (cp >= 0xD800 && cp <= 0xDBFF && i < len && src[i] >= 0xDC00 && src[i] <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (src[i++] - 0xDC00);
+                *out++ = static_cast<char>(0xF0 | (cp >> 18));
+                *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                continue;
+            }
+            // Lone surrogates are replaced with U+FFFD
+            if (cp >= 0xD800 && cp <= 0xDFFF) cp = 0xFFFD;
+            *out++ = static_cast<char>(0xE0 | (cp >> 12));
+            *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return static_cast<size_t>(out - dst);
+    }
+
+    std::string utf16_to_utf8(const std::u16string& s) {
+        std::string out;
+        out.resize(s.size() * 3);
+        out.resize(utf16_to_utf8(s.data(), s.size(), out.data()));
+        return out;
+    }
+
+    void read_u16_units(const uint8_t* p, size_t count, char16_t* dst) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<char16_t>(p[2 * i] | (static_cast<char16_t>(p[2 * i + 1]) << 8));
+        }
+#else
+        std::memcpy(dst, p, count * 2);
+#endif
     }
 
     std::u16string parse_name(const std::vector<uint8_t>& name_b) {
         std::u16string name;
-        for (size_t i = 0; i + 1 < name_b.size(); i += 2) {
-            char16_t ch = static_cast<char16_t>(name_b[i] | (static_cast<char16_t>(name_b[i + 1]) << 8));
-            if (ch == 0) break;
-            name.push_back(ch);
-        }
+        name.resize(u16_strnlen(name_b.data(), name_b.size() / 2));
+        read_u16_units(name_b.data(), name.size(), name.data());
         return name;
     }
 }
@@ -3,16 +3,24 @@
 #include <string>
 #include <vector>
 
-#include <codecvt>
 #include <cstring>
-#include <iostream>
-#include <locale>
-#include <ostream>
+#include <stdexcept>
+
+#include "ParseResult.h"
 
 namespace fssm::parse {
     uint8_t read_u8_le(const uint8_t* p);
     uint32_t read_u32_le(const uint8_t* p);
     uint64_t read_u64_le(const uint8_t* p);
+    void write_u16_le(uint8_t* p, uint16_t v);
+    void write_u32_le(uint8_t* p, uint32_t v);
+    void write_u64_le(uint8_t* p, uint64_t v);
+    // Number of UTF-16 code units before NUL terminator, at most 'maxUnits'
+    size_t u16_strnlen(const uint8_t* p, size_t maxUnits);
+    // Copy little-endian UTF-16 code units from raw bytes
+    void read_u16_units(const uint8_t* p, size_t count, char16_t* dst);
+    // Writes to 'dst' which must have space for at least 'len * 3' bytes, returns number of bytes written
+    size_t utf16_to_utf8(const char16_t* src, size_t len, char* dst);
     std::string utf16_to_utf8(const std::u16string& s);
     std::u16string parse_name(const std::vector<uint8_t>& name_b);
 
@@ -53,8 +61,9 @@ namespace fssm::parse {
     }
     class ContentReader {
     public:
-        explicit ContentReader(const std::vector<uint8_t>& content)
-        : m_data(content.data()), m_size(content.size()), m_pos(0) {}
+        // 'entryIndex' of container entry is used only in error messages
+        explicit ContentReader(const std::vector<uint8_t>& content, int entryIndex = -1)
+        : m_data(content.data()), m_size(content.size()), m_pos(0), m_entryIndex(entryIndex) {}
         template <class T>
         T read(Endianness e) {
             T v;
@@ -73,33 +82,42 @@ namespace fssm::parse {
         int32_t  read_i32_be() { return static_cast<int32_t>(read<uint32_t>(Endianness::Big)); }
 
         std::vector<uint8_t> read_vec_u8(size_t size) {
-            std::vector<uint8_t> v;
-            v.reserve(size);
-            v.assign(m_data + m_pos, m_data + m_pos + size);
+            if (size > m_size - m_pos) throwPastEnd(size);
+            std::vector<uint8_t> v(m_data + m_pos, m_data + m_pos + size);
             m_pos += size;
             return v;
         }
 
         std::u16string read_u16_string(size_t size) {
+            if (size > (m_size - m_pos) / 2) throwPastEnd(2 * size);
             std::u16string s;
-            for (size_t i = 0; i < size; ++i) {
-                char16_t ch = m_data[m_pos + (2 * i)] | static_cast<char16_t>(m_data[m_pos + (2 * i) + 1]) << 8;
-                if (ch == 0) break;
-                s.push_back(ch);
-            }
+            s.resize(u16_strnlen(m_data + m_pos, size));
+            read_u16_units(m_data + m_pos, s.size(), s.data());
             m_pos += (2 * size);
             return s;
         }
+        // Bounds are checked as 'n > remaining' so huge sizes read from corrupted files can't overflow
         void copyTo(void* dest, size_t n) {
-            if (m_pos + n > m_size) throw std::out_of_range("read past end");
+            if (n > m_size - m_pos) throwPastEnd(n);
             std::memcpy(dest, m_data + m_pos, n);
             m_pos += n;
         }
-        void skip(int n) { m_pos += n; }
+        size_t pos() const { return m_pos; }
+        void skip(size_t n) {
+            if (n > m_size - m_pos) throwPastEnd(n);
+            m_pos += n;
+        }
 
     private:
+        [[noreturn]] void throwPastEnd(size_t n) const {
+            std::string message = "Read of " + std::to_string(n) + " bytes past end of ";
+            message += m_entryIndex < 0 ? std::string("content") : "entry " + std::to_string(m_entryIndex);
+            throw ParseException(ParseErrorCode::OutOfBounds, static_cast<int64_t>(m_pos), message);
+        }
+
         const uint8_t* m_data;
         size_t m_size;
         size_t m_pos;
+        int m_entryIndex;
     };
 }
@@ -0,0 +1,99 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <QCoreApplication>
+
+const char PackMagic[] = "FSSMPACK";
+const quint32 PackVersion = 1;
+
+static quint16 readU16(const uchar* data) {
+    return quint16(data[0]) | (quint16(data[1]) << 8);
+}
+
+static quint32 readU32(const uchar* data) {
+    return quint32(readU16(data)) | (quint32(readU16(data + 2)) << 16);
+}
+
+static quint64 readU64(const uchar* data) {
+    return quint64(readU32(data)) | (quint64(readU32(data + 4)) << 32);
+}
+
+AssetPack* AssetPack::instance() {
+    static AssetPack pack(QCoreApplication::applicationDirPath() + "/fssm_assets.pack");
+    return &pack;
+}
+
+AssetPack::AssetPack(const QString& filepath): m_file(filepath) {
+    if (!m_file.open(QIODevice::ReadOnly)) return;
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_file.size());
+    if (m_data == nullptr) return;
+    if (!parseIndex()) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+        m_data = nullptr;
+        m_entries.clear();
+    }
+}
+
+bool AssetPack::parseIndex() {
+    if (m_size < 16 || std::memcmp(m_data, PackMagic, 8) != 0) return false;
+    if (readU32(m_data + 8) != PackVersion) return false;
+    const quint32 count = readU32(m_data + 12);
+
+    m_entries.reserve(count);
+    quint64 pos = 16;
+    for (quint32 idx = 0; idx < count; ++idx) {
+        if (pos + 2 > m_size) return false;
+        const quint16 keySize = readU16(m_data + pos);
+        pos += 2;
+        if (pos + keySize + 16 > m_size) return false;
+        Entry entry;
+        entry.key = QString::fromUtf8(reinterpret_cast<const char*>(m_data + pos), keySize);
+        pos += keySize;
+        entry.offset = readU64(m_data + pos);
+        entry.size = readU64(m_data + pos + 8);
+        pos += 16;
+        if (entry.offset > m_size || entry.size > m_size - entry.offset) return false;
+        m_entries.push_back(std::move(entry));
+    }
+    // Keys are written sorted, sort again in case the comparison differs
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry& left, const Entry& right) {
+        return left.key < right.key;
+    });
+    return true;
+}
+
+const AssetPack::Entry* AssetPack::findEntry(const QString& path) const {
+    if (!isOpen()) return nullptr;
+    // Resource paths start with ':/' which is not part of the key
+    QStringView key(path);
+    if (key.startsWith(u":/")) key = key.mid(2);
+    auto it = std::lower_bound(
+        m_entries.begin(),
+        m_entries.end(),
+        key,
+        [](const Entry& entry, const QStringView& value) { return QStringView(entry.key) < value; }
+    );
+    if (it == m_entries.end() || it->key != key) return nullptr;
+    return &(*it);
+}
+
+bool AssetPack::contains(const QString& path) const {
+    return findEntry(path) != nullptr;
+}
+
+QByteArray AssetPack::data(const QString& path) const {
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr) return QByteArray{};
+    return QByteArray::fromRawData(
+        reinterpret_cast<const char*>(m_data + entry->offset),
+        static_cast<qsizetype>(entry->size)
+    );
+}
+
+QImage AssetPack::image(const QString& path) const {
+    const QByteArray bytes = data(path);
+    if (bytes.isEmpty()) return QImage{};
+    return QImage::fromData(bytes);
+}
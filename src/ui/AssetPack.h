@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QString>
+
+// Read only pack of inventory resources created by 'gen_resources.py --pack'
+// - the file is memory mapped, images are decoded only when requested
+// - paths use the same form as qrc resources, e.g. ':/ds3_inv_images/affinity'
+// - the pack is opened once and not modified, so it can be used from worker threads
+class AssetPack {
+public:
+    static AssetPack* instance();
+
+    bool isOpen() const { return m_data != nullptr; }
+    bool contains(const QString& path) const;
+    // Data of the file, points directly to mapped memory
+    QByteArray data(const QString& path) const;
+    QImage image(const QString& path) const;
+
+private:
+    struct Entry {
+        QString key;
+        quint64 offset;
+        quint64 size;
+    };
+
+    explicit AssetPack(const QString& filepath);
+    bool parseIndex();
+    const Entry* findEntry(const QString& path) const;
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    quint64 m_size = 0;
+    // Sorted by key
+    std::vector<Entry> m_entries;
+};
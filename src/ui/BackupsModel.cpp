@@ -8,6 +8,8 @@
 #include <thread>
 
 #include "Utils.h"
+#include "../parse/Metrics.h"
+#include "../parse/Trace.h"
 
 using json = nlohmann::json;
 
@@ -289,7 +291,10 @@ std::optional<BackupMetadata> BackupsModel::createBackup(const QString& savePath
     backupDir = indexExistingPath(backupDir);
     std::string dstPath = backupDir + "\\" + filename;
     std::filesystem::create_directory(backupDir);
-    std::filesystem::copy_file(stdSavePath, dstPath);
+    {
+        FSSM_TRACE_SCOPE("backup.copy");
+        std::filesystem::copy_file(stdSavePath, dstPath);
+    }
     std::string metadataPath = backupDir + "\\metadata.json";
 
     std::string labelStd = label.toStdString();
@@ -304,10 +309,13 @@ std::optional<BackupMetadata> BackupsModel::createBackup(const QString& savePath
         labelStd,
         backupDir
     );
-    json jsonMetadata = backupMetadataToJson(metadata);
-    std::ofstream o(metadataPath);
-    o << jsonMetadata.dump(4) << std::endl;
-    o.close();
+    {
+        FSSM_TRACE_SCOPE("backup.write_metadata");
+        json jsonMetadata = backupMetadataToJson(metadata);
+        std::ofstream o(metadataPath);
+        o << jsonMetadata.dump(4) << std::endl;
+        o.close();
+    }
     emit createBackupFinished(true, backupType);
     return metadata;
 }
@@ -333,6 +341,7 @@ void BackupsModel::saveBackupMetadata(const BackupMetadata& metadata) {
     // Check if path to backup exists
     std::string metadataPath = metadata.backupDir + "\\metadata.json";
     if (!std::filesystem::exists(metadataPath)) return;
+    FSSM_TRACE_SCOPE("backup.write_metadata");
     json jsonMetadata = backupMetadataToJson(metadata);
     std::ofstream o(metadataPath);
     o << jsonMetadata.dump(4) << std::endl;
@@ -358,6 +367,7 @@ std::string BackupsModel::getGameBackupDir(const fssm::Game& game) {
 }
 
 std::vector<BackupMetadata> BackupsModel::getBackupItems(const fssm::Game &game) {
+    FSSM_TRACE_SCOPE("backup.scan_catalog");
     std::vector<BackupMetadata> output;
     std::string gameBackupDir = getGameBackupDir(game);
     if (!std::filesystem::exists(gameBackupDir)) return output;
@@ -374,10 +384,28 @@ std::vector<BackupMetadata> BackupsModel::getBackupItems(const fssm::Game &game)
             output.push_back(metadateItem.value());
         }
     }
+    fssm::metrics::gauge("backups.count." + game.toString()).set(static_cast<int64_t>(output.size()));
     return output;
 }
 
+uint64_t BackupsModel::getBackupsSize(const fssm::Game& game) {
+    FSSM_TRACE_SCOPE("backup.scan_size");
+    uint64_t totalBytes = 0;
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator it(getGameBackupDir(game), ec);
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        // Size is cached by directory listing on Windows, no additional stat of each file
+        std::error_code sizeEc;
+        if (!it->is_regular_file(sizeEc)) continue;
+        uintmax_t size = it->file_size(sizeEc);
+        if (!sizeEc) totalBytes += size;
+    }
+    fssm::metrics::gauge("backups.bytes." + game.toString()).set(static_cast<int64_t>(totalBytes));
+    return totalBytes;
+}
+
 bool BackupsModel::restoreBackupSave(const QString& dstSavePath, const BackupMetadata &metadata) {
+    FSSM_TRACE_SCOPE("backup.restore");
     auto [dstDir, dstFilename] = splitPath(dstSavePath.toStdString());
     if (!std::filesystem::exists(dstDir)) {
         std::filesystem::create_directory(dstDir);
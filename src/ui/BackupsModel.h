@@ -82,6 +82,8 @@ public:
 
     std::string getGameBackupDir(const fssm::Game& game);
     std::vector<BackupMetadata> getBackupItems(const fssm::Game& game);
+    // Sum sizes of all files in backups of the game, needs stat of each file so it is not part of scan
+    uint64_t getBackupsSize(const fssm::Game& game);
     bool restoreBackupSave(const QString& dstSavePath, const BackupMetadata& backupItem);
     bool restoreBackupById(const QString& dstSavePath, const fssm::Game &game, const QString& backupId);
     bool quickLoad(const QString& dstSavePath, const fssm::Game &game);
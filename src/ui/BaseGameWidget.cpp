@@ -0,0 +1,85 @@
+#include "BaseGameWidget.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QtConcurrent/QtConcurrentRun>
+
+BaseGameWidget::BaseGameWidget(Controller* controller, QString saveId, QWidget* parent)
+    : QWidget(parent),
+    m_controller(controller),
+    m_saveId(std::move(saveId))
+{
+    m_bgWatcher = new QFutureWatcher<QImage>(this);
+    connect(m_bgWatcher, SIGNAL(finished()), this, SLOT(onBackgroundRendered()));
+}
+
+void BaseGameWidget::setBackgroundRenderer(BackgroundRenderer renderer) {
+    m_bgRenderer = std::move(renderer);
+    m_bgCache = QPixmap{};
+    m_bgCacheSize = QSize{};
+    update();
+}
+
+QImage BaseGameWidget::renderCoverBackground(
+    const QImage& source,
+    const QSize& size,
+    qreal devicePixelRatio,
+    const QColor& color,
+    Qt::Alignment alignment
+) {
+    QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(color);
+    if (source.isNull() || size.isEmpty()) return image;
+
+    QImage scaled = source.scaled(image.size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(devicePixelRatio);
+    const QSizeF scaledSize = scaled.deviceIndependentSize();
+    qreal x = 0;
+    qreal y = 0;
+    if (alignment & Qt::AlignHCenter) x = (size.width() - scaledSize.width()) / 2;
+    if (alignment & Qt::AlignVCenter) y = (size.height() - scaledSize.height()) / 2;
+
+    QPainter painter(&image);
+    painter.drawImage(QPointF(x, y), scaled);
+    return image;
+}
+
+void BaseGameWidget::paintEvent(QPaintEvent* event) {
+    if (!m_bgRenderer) return;
+
+    QPainter painter(this);
+    painter.setClipRect(event->rect());
+    const qreal dpr = devicePixelRatioF();
+    if (m_bgCacheSize != size() || m_bgCacheDpr != dpr) {
+        if (m_bgCache.isNull()) {
+            m_bgCache = QPixmap::fromImage(m_bgRenderer(size(), dpr));
+            m_bgCacheSize = size();
+            m_bgCacheDpr = dpr;
+        } else {
+            // Live resize, stretch previous background until new one is rendered
+            painter.drawPixmap(rect(), m_bgCache);
+            requestBackgroundRender();
+            return;
+        }
+    }
+    painter.drawPixmap(0, 0, m_bgCache);
+}
+
+void BaseGameWidget::requestBackgroundRender() {
+    // Result of running render is checked when finished
+    if (m_bgWatcher->isRunning()) return;
+    m_bgRenderSize = size();
+    m_bgRenderDpr = devicePixelRatioF();
+    m_bgWatcher->setFuture(QtConcurrent::run(m_bgRenderer, m_bgRenderSize, m_bgRenderDpr));
+}
+
+void BaseGameWidget::onBackgroundRendered() {
+    m_bgCache = QPixmap::fromImage(m_bgWatcher->result());
+    m_bgCacheSize = m_bgRenderSize;
+    m_bgCacheDpr = m_bgRenderDpr;
+    if (m_bgCacheSize != size() || m_bgCacheDpr != devicePixelRatioF()) {
+        requestBackgroundRender();
+    }
+    update();
+}
@@ -1,17 +1,47 @@
 #pragma once
 #include <QWidget>
+#include <QFutureWatcher>
+#include <QImage>
+#include <functional>
 #include <utility>
 #include "Controller.h"
 
+// Renders background image for widget size and device pixel ratio
+// - is called from worker threads so it must not access the widget
+using BackgroundRenderer = std::function<QImage(const QSize& size, qreal devicePixelRatio)>;
 
 class BaseGameWidget: public QWidget {
     Q_OBJECT
 signals:
     void showBackupsRequested();
 public:
-    explicit BaseGameWidget(Controller* controller, QString saveId, QWidget* parent): QWidget(parent), m_controller(controller), m_saveId(std::move(saveId)) {};
+    explicit BaseGameWidget(Controller* controller, QString saveId, QWidget* parent);
     virtual void refresh() = 0;
+protected:
+    void setBackgroundRenderer(BackgroundRenderer renderer);
+    // Background filled with color and source image scaled to cover whole size
+    static QImage renderCoverBackground(
+        const QImage& source,
+        const QSize& size,
+        qreal devicePixelRatio,
+        const QColor& color,
+        Qt::Alignment alignment
+    );
+    void paintEvent(QPaintEvent* event) override;
+private slots:
+    void onBackgroundRendered();
 private:
+    void requestBackgroundRender();
+
     QString m_saveId;
     Controller* m_controller;
+
+    // Background is rendered once per size and device pixel ratio
+    BackgroundRenderer m_bgRenderer;
+    QPixmap m_bgCache;
+    QSize m_bgCacheSize;
+    qreal m_bgCacheDpr = 0;
+    QFutureWatcher<QImage>* m_bgWatcher = nullptr;
+    QSize m_bgRenderSize;
+    qreal m_bgRenderDpr = 0;
 };
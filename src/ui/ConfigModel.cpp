@@ -126,6 +126,8 @@ ConfigSettingsData ConfigModel::getConfigSettingsData() {
         .autobackupEnabled = m_configData.autobackup.enabled,
         .autobackupFrequency = m_configData.autobackup.frequency,
         .maxAutobackups = m_configData.autobackup.maxBackups,
+
+        .tracingEnabled = m_configData.diagnostics.tracingEnabled,
     };
 }
 
@@ -133,6 +135,7 @@ void ConfigModel::saveConfigData(const ConfigConfirmData& confirmData) {
     bool l_pathsChanged = false;
     bool l_hotkeyChanged = false;
     bool l_autobackupChanged = false;
+    bool l_diagnosticsChanged = false;
 
     auto& gsf = m_configData.gameSaveFiles;
     auto updatePathIfSet = [&](const std::optional<QString>& confirmPath, ConfigSavePathData& savePathInfo) {
@@ -173,7 +176,11 @@ void ConfigModel::saveConfigData(const ConfigConfirmData& confirmData) {
         l_autobackupChanged = true;
         m_configData.autobackup.maxBackups = confirmData.maxAutobackups.value();
     }
-    bool changed = l_pathsChanged || l_hotkeyChanged || l_autobackupChanged;
+    if (confirmData.tracingEnabled.has_value()) {
+        l_diagnosticsChanged = true;
+        m_configData.diagnostics.tracingEnabled = confirmData.tracingEnabled.value();
+    }
+    bool changed = l_pathsChanged || l_hotkeyChanged || l_autobackupChanged || l_diagnosticsChanged;
     if (!changed) return;
 
     saveConfig();
@@ -181,6 +188,7 @@ void ConfigModel::saveConfigData(const ConfigConfirmData& confirmData) {
     if (l_pathsChanged) emit pathsChanged();
     if (l_hotkeyChanged) emit hotkeysChanged();
     if (l_autobackupChanged) emit autoBackupChanged();
+    if (l_diagnosticsChanged) emit diagnosticsChanged();
     emit configChanged();
 }
 
@@ -271,6 +279,10 @@ ConfigAutobackup ConfigModel::getAutosaveConfig() const {
     return m_configData.autobackup;
 }
 
+ConfigDiagnostics ConfigModel::getDiagnosticsConfig() const {
+    return m_configData.diagnostics;
+}
+
 void ConfigModel::p_loadConfig() {
     if (m_configData.isLoaded) return;
     m_configData.isLoaded = true;
@@ -379,6 +391,14 @@ void ConfigModel::p_loadConfig() {
     if (maxAutobackupsIt != autobackupData.end() && maxAutobackupsIt->is_number())
         autobackup.maxBackups = maxAutobackupsIt.value();
 
+    // Diagnostics
+    auto diagnosticsIt = data.find("diagnostics");
+    if (diagnosticsIt != data.end() && diagnosticsIt->is_object()) {
+        auto tracingIt = diagnosticsIt->find("tracing_enabled");
+        if (tracingIt != diagnosticsIt->end() && tracingIt->is_boolean())
+            m_configData.diagnostics.tracingEnabled = tracingIt.value();
+    }
+
     // Last selected save id
     auto lastIdIt = data.find("last_selected_save_id");
     if (lastIdIt != data.end() && lastIdIt->is_string())
@@ -404,10 +424,14 @@ json ConfigModel::p_configToJson() {
     autobackup["frequency"] = m_configData.autobackup.frequency;
     autobackup["max_autobackups"] = m_configData.autobackup.maxBackups;
 
+    json diagnostics = json::object();
+    diagnostics["tracing_enabled"] = m_configData.diagnostics.tracingEnabled;
+
     json data = json::object();
     data["game_save_files"] = game_save_files;
     data["hotkeys"] = hotkeys;
     data["autobackup"] = autobackup;
+    data["diagnostics"] = diagnostics;
     data["last_selected_save_id"] = m_configData.lastSaveId.toStdString();
     return data;
 }
@@ -48,12 +48,18 @@ struct ConfigAutobackup {
     int maxBackups = 10;
 };
 
+struct ConfigDiagnostics {
+    // Record trace spans, see 'parse/Trace.h'
+    bool tracingEnabled = false;
+};
+
 struct ConfigData {
     bool isLoaded = false;
     QString lastSaveId = "";
     ConfigGameSavePaths gameSaveFiles {};
     ConfigHotkeys hotkeys {};
     ConfigAutobackup autobackup {};
+    ConfigDiagnostics diagnostics {};
 };
 
 // --------------------------
@@ -78,6 +84,8 @@ struct ConfigSettingsData {
     bool autobackupEnabled;
     int autobackupFrequency;
     int maxAutobackups;
+
+    bool tracingEnabled;
 };
 
 struct ConfigConfirmData {
@@ -94,6 +102,7 @@ struct ConfigConfirmData {
     std::optional<int> autobackupFrequency;
     std::optional<int> maxAutobackups;
 
+    std::optional<bool> tracingEnabled;
 };
 
 class ConfigModel: public QObject {
@@ -102,6 +111,7 @@ signals:
     void pathsChanged();
     void hotkeysChanged();
     void autoBackupChanged();
+    void diagnosticsChanged();
     void configChanged();
 public:
     explicit ConfigModel(QObject* parent);
@@ -123,6 +133,7 @@ public:
     ConfigGameSavePaths getSaveFilesConfig() const;
     ConfigHotkeys getHotkeysConfig() const;
     ConfigAutobackup getAutosaveConfig() const;
+    ConfigDiagnostics getDiagnosticsConfig() const;
 private:
     ConfigData m_configData;
     QString m_appConfigPath = "";
@@ -2,9 +2,13 @@
 
 #include <QDesktopServices>
 #include <QUrl>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 
+#include "../parse/Metrics.h"
+#include "../parse/Trace.h"
+
 
 HotkeysThread::HotkeysThread(const ConfigHotkeys& config, QObject* parent): QThread(parent) {
     updateHotkeys(config);
@@ -88,12 +92,16 @@ void SaveChangesThread::stop() {
 void SaveChangesThread::run() {
     m_isRunning = true;
 
+    fssm::metrics::Counter& pollsCounter = fssm::metrics::counter("watcher.polls");
+    fssm::metrics::Counter& eventsCounter = fssm::metrics::counter("watcher.events");
     while (m_isRunning) {
         for (auto& [saveId, path]: m_saveFilesBySaveId) {
+            pollsCounter.add();
             std::filesystem::file_time_type& oldMod = m_lastChangedById[saveId];
             std::filesystem::file_time_type newMod = getFileModificationTime(path);
             if (oldMod == newMod) continue;
             m_lastChangedById[saveId] = newMod;
+            eventsCounter.add();
             emit saveFileChanged(saveId);
         }
         msleep(1000);
@@ -102,6 +110,8 @@ void SaveChangesThread::run() {
 
 // --- Controller ---
 Controller::Controller(QObject* parent): QObject(parent) {
+    m_envTracePath = QString::fromStdString(fssm::trace::init_from_environment());
+
     m_saveSound = new QSoundEffect(this);
     m_saveSound->setSource(QUrl("qrc:/audio/soul_suck.wav"));
     m_saveSound->setVolume(0.5);
@@ -115,10 +125,12 @@ Controller::Controller(QObject* parent): QObject(parent) {
     m_backupsModel = new BackupsModel(saveFileItems, m_configModel->getAutosaveConfig(), m_configModel->getBackupDirPath(), this);
     m_hotkeysThread = new HotkeysThread(m_configModel->getHotkeysConfig(), this);
     m_saveChangesThread = new SaveChangesThread(saveFileItems, this);
+    onDiagnosticsChange();
 
     connect(m_configModel, SIGNAL(pathsChanged()), this, SLOT(onGamePathsChange()));
     connect(m_configModel, SIGNAL(hotkeysChanged()), this, SLOT(onHotkeysChange()));
     connect(m_configModel, SIGNAL(autoBackupChanged()), this, SLOT(onAutobackupChange()));
+    connect(m_configModel, SIGNAL(diagnosticsChanged()), this, SLOT(onDiagnosticsChange()));
 
     connect(m_hotkeysThread, SIGNAL(quickSaveRequested()), this, SLOT(onQuickSaveRequest()));
     connect(m_hotkeysThread, SIGNAL(quickLoadRequested()), this, SLOT(onQuickLoadRequest()));
@@ -143,6 +155,8 @@ Controller::~Controller() {
 
     m_configModel->saveConfig();
     delete m_configModel;
+
+    if (!m_envTracePath.isEmpty()) writeTrace(m_envTracePath);
 }
 
 QString Controller::getLastSelectedSaveId() const {
@@ -172,61 +186,76 @@ std::vector<SaveFileItem> Controller::getSaveFileItems() const {
 
 DSRCharInfoResult Controller::getDsrCharacters(const QString& saveId) const {
     QString r_savePath = m_configModel->getSavePathItem(saveId);
-    if (r_savePath.isEmpty()) return {
-        "Save file path is not set.",
-        std::vector<fssm::parse::dsr::DSRCharacterInfo> {},
-    };
+    if (r_savePath.isEmpty()) return {"Save file path is not set.", nullptr};
     std::string savePath = r_savePath.toStdString();
-    if (!std::filesystem::exists(savePath)) return {
-        "Save file does not exist.",
-        std::vector<fssm::parse::dsr::DSRCharacterInfo> {},
-    };
-    fssm::parse::SL2File sl2_dsr = fssm::parse::parse_sl2_file(savePath);
-    fssm::parse::dsr::DSRSaveFile dsr = fssm::parse::dsr::parse_dsr_file(sl2_dsr);
+    if (!std::filesystem::exists(savePath)) return {"Save file does not exist.", nullptr};
+    auto sl2Result = fssm::parse::try_parse_sl2_file(savePath);
+    if (!sl2Result) return {QString::fromStdString(sl2Result.error().toString()), nullptr};
+    // Container is not used anymore, its entries are moved to the parsed save
+    auto dsrResult = fssm::parse::dsr::try_parse_dsr_file(std::move(sl2Result).value());
+    if (!dsrResult) return {QString::fromStdString(dsrResult.error().toString()), nullptr};
 
     return {
         "",
-        dsr.characters
+        std::make_shared<const fssm::parse::dsr::DSRSaveFile>(std::move(dsrResult).value())
     };
 }
 
 DS3CharInfoResult Controller::getDs3Characters(const QString& saveId) const {
     QString r_savePath = m_configModel->getSavePathItem(saveId);
-    if (r_savePath.isEmpty()) return {
-        "Save file path is not set.",
-        std::vector<fssm::parse::ds3::DS3CharacterInfo> {},
-    };
+    if (r_savePath.isEmpty()) return {"Save file path is not set.", nullptr};
     std::string savePath = r_savePath.toStdString();
-    if (!std::filesystem::exists(savePath)) return {
-        "Save file does not exist.",
-        std::vector<fssm::parse::ds3::DS3CharacterInfo> {},
-    };
-    fssm::parse::SL2File sl2_dsr = fssm::parse::parse_sl2_file(savePath);
-    fssm::parse::ds3::DS3SaveFile ds3 = fssm::parse::ds3::parse_ds3_file(sl2_dsr);
+    if (!std::filesystem::exists(savePath)) return {"Save file does not exist.", nullptr};
+    auto sl2Result = fssm::parse::try_parse_sl2_file(savePath);
+    if (!sl2Result) return {QString::fromStdString(sl2Result.error().toString()), nullptr};
+    fssm::parse::ds3::InitialOffsetCache* offsetCache;
+    {
+        std::lock_guard<std::mutex> lock(m_ds3OffsetCachesMutex);
+        auto& cache = m_ds3OffsetCaches[saveId];
+        if (!cache) cache = std::make_unique<fssm::parse::ds3::InitialOffsetCache>();
+        offsetCache = cache.get();
+    }
+    // Container is not used anymore, its entries are moved to the parsed save
+    auto ds3Result = fssm::parse::ds3::try_parse_ds3_file(std::move(sl2Result).value(), offsetCache);
+    if (!ds3Result) return {QString::fromStdString(ds3Result.error().toString()), nullptr};
 
     return {
         "",
-        ds3.characters
+        std::make_shared<const fssm::parse::ds3::DS3SaveFile>(std::move(ds3Result).value())
     };
 }
 
 ERCharInfoResult Controller::getERCharacters(const QString& saveId) const {
     QString r_savePath = m_configModel->getSavePathItem(saveId);
-    if (r_savePath.isEmpty()) return {
-        "Save file path is not set.",
-        std::vector<fssm::parse::er::ERCharacterInfo> {},
-    };
+    if (r_savePath.isEmpty()) return {"Save file path is not set.", nullptr};
     std::string savePath = r_savePath.toStdString();
-    if (!std::filesystem::exists(savePath)) return {
-        "Save file does not exist.",
-        std::vector<fssm::parse::er::ERCharacterInfo> {},
+    if (!std::filesystem::exists(savePath)) return {"Save file does not exist.", nullptr};
+    // Character list needs only slot summaries from USERDATA_10
+    auto sl2Result = fssm::parse::try_parse_sl2_file(savePath, {10});
+    if (!sl2Result) return {QString::fromStdString(sl2Result.error().toString()), nullptr};
+    auto userDataResult = fssm::parse::er::try_parse_er_user_data(sl2Result.value());
+    if (!userDataResult) return {QString::fromStdString(userDataResult.error().toString()), nullptr};
+
+    return {
+        "",
+        std::make_shared<const fssm::parse::er::UserData10>(std::move(userDataResult).value())
     };
-    fssm::parse::SL2File sl2_dsr = fssm::parse::parse_sl2_file(savePath);
-    fssm::parse::er::ERSaveFile er = fssm::parse::er::parse_er_file(sl2_dsr);
+}
 
+ERCharacterResult Controller::getERCharacter(const QString& saveId, const int& index) const {
+    QString r_savePath = m_configModel->getSavePathItem(saveId);
+    if (r_savePath.isEmpty()) return {"Save file path is not set.", nullptr};
+    std::string savePath = r_savePath.toStdString();
+    if (!std::filesystem::exists(savePath)) return {"Save file does not exist.", nullptr};
+    if (index < 0 || index >= 10) return {"Invalid character index.", nullptr};
+
+    auto sl2Result = fssm::parse::try_parse_sl2_file(savePath, {static_cast<uint32_t>(index)});
+    if (!sl2Result) return {QString::fromStdString(sl2Result.error().toString()), nullptr};
+    auto charResult = fssm::parse::er::try_parse_er_character(sl2Result.value(), static_cast<uint8_t>(index));
+    if (!charResult) return {QString::fromStdString(charResult.error().toString()), nullptr};
     return {
         "",
-        er.characters
+        std::make_shared<const fssm::parse::er::ERCharacterInfo>(std::move(charResult).value())
     };
 }
 
@@ -239,20 +268,44 @@ void Controller::openBackupDir() {
     QDesktopServices::openUrl(QUrl::fromLocalFile(QString::fromStdString(backupDir)));
 }
 
+bool Controller::writeTrace(const QString& path) const {
+    return fssm::trace::write_trace(path.toStdString());
+}
+
+uint64_t Controller::getTraceSpanCount() const {
+    return fssm::trace::span_count();
+}
+
+fssm::metrics::Snapshot Controller::getMetrics() const {
+    return fssm::metrics::snapshot();
+}
+
+void Controller::updateBackupSizes() {
+    for (fssm::Game game: {fssm::Game::DSR, fssm::Game::DS2_SOTFS, fssm::Game::DS3, fssm::Game::Sekiro, fssm::Game::ER}) {
+        m_backupsModel->getBackupsSize(game);
+    }
+}
+
 void Controller::onQuickSaveRequest() {
+    FSSM_TRACE_SCOPE("controller.quick_save");
+    auto start = std::chrono::steady_clock::now();
     if (m_currentSaveId.isEmpty()) return;
     auto itemOpt = m_configModel->getSaveItem(m_currentSaveId);
     if (!itemOpt.has_value()) return;
     QString savePath = itemOpt.value().savePath;
     if (savePath.isEmpty()) return;
     m_backupsModel->createQuickSaveBackup(savePath, itemOpt.value().game);
+    fssm::metrics::latency("quicksave").record(start);
 };
 
 void Controller::onQuickLoadRequest() {
+    FSSM_TRACE_SCOPE("controller.quick_load");
+    auto start = std::chrono::steady_clock::now();
     if (m_currentSaveId.isEmpty()) return;
     auto itemOpt = m_configModel->getSaveItem(m_currentSaveId);
     if (!itemOpt.has_value()) return;
     m_backupsModel->quickLoad(itemOpt.value().savePath, itemOpt.value().game);
+    fssm::metrics::latency("quickload").record(start);
 }
 
 std::vector<BackupMetadata> Controller::getBackupItems() {
@@ -306,6 +359,12 @@ void Controller::onAutobackupChange() {
     emit autobackupConfigChanged();
 }
 
+void Controller::onDiagnosticsChange() {
+    // Environment variable keeps tracing enabled regardless of settings
+    bool enabled = m_configModel->getDiagnosticsConfig().tracingEnabled || !m_envTracePath.isEmpty();
+    fssm::trace::set_enabled(enabled);
+}
+
 // Save file changed
 void Controller::onSaveFileChange(const QString& saveId) {
     m_backupsModel->saveGameChanged(saveId);
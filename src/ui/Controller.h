@@ -2,11 +2,15 @@
 
 #include <QThread>
 #include <QSoundEffect>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "KeysWindows.h"
 #include "ConfigModel.h"
 #include "BackupsModel.h"
+#include "../parse/Metrics.h"
 #include "../parse/Parse.h"
 
 // Handler of hotkeys presss
@@ -50,22 +54,31 @@ private:
     std::unordered_map<QString, std::filesystem::file_time_type> m_lastChangedById;
 };
 
-// Result to receive characters of DSR save file
+// Parsed data in results are immutable snapshots, they can be shared between threads and widgets without copies
+// - snapshot is freed when the last widget using it drops its pointer
+
+// Result to receive characters of DSR save file, 'saveFile' is not set on error
 struct DSRCharInfoResult {
     QString error;
-    std::vector<fssm::parse::dsr::DSRCharacterInfo> characters;
+    std::shared_ptr<const fssm::parse::dsr::DSRSaveFile> saveFile;
 };
 
-// Result to receive characters of DS3 save file
+// Result to receive characters of DS3 save file, 'saveFile' is not set on error
 struct DS3CharInfoResult {
     QString error;
-    std::vector<fssm::parse::ds3::DS3CharacterInfo> characters;
+    std::shared_ptr<const fssm::parse::ds3::DS3SaveFile> saveFile;
 };
 
-// Result to receive characters of ER save file
+// Result to receive character summaries of ER save file, 'userData10' is not set on error
 struct ERCharInfoResult {
     QString error;
-    std::vector<fssm::parse::er::ERCharacterInfo> characters;
+    std::shared_ptr<const fssm::parse::er::UserData10> userData10;
+};
+
+// Result to receive fully parsed character of ER save file
+struct ERCharacterResult {
+    QString error;
+    std::shared_ptr<const fssm::parse::er::ERCharacterInfo> character;
 };
 
 // Controller wrapping backend logic allowing UI to access data it needs
@@ -94,6 +107,7 @@ public:
     DS3CharInfoResult getDs3Characters(const QString& saveId) const;
     // SekiroCharInfoResult getSekiroCharacters(const QString& saveId) const;
     ERCharInfoResult getERCharacters(const QString& saveId) const;
+    ERCharacterResult getERCharacter(const QString& saveId, const int& index) const;
 
     std::vector<BackupMetadata> getBackupItems();
     std::optional<BackupMetadata> createManualBackup();
@@ -103,12 +117,21 @@ public:
 
     void openBackupDir();
 
+    // Write recorded trace spans to file, tracing is enabled in settings or by 'FSSM_TRACE' env variable
+    bool writeTrace(const QString& path) const;
+    uint64_t getTraceSpanCount() const;
+    // Current values of metrics shown in diagnostics
+    fssm::metrics::Snapshot getMetrics() const;
+    // Update 'backups.bytes.<game>' gauges, slow with many backups so it is called from worker thread
+    void updateBackupSizes();
+
 private slots:
     void onQuickSaveRequest();
     void onQuickLoadRequest();
     void onGamePathsChange();
     void onHotkeysChange();
     void onAutobackupChange();
+    void onDiagnosticsChange();
     void onSaveFileChange(const QString& saveId);
     void onBackupCreate(bool success, BackupType backupType);
     void onBackupLoad(bool success);
@@ -121,4 +144,9 @@ private:
     BackupsModel* m_backupsModel;
     HotkeysThread* m_hotkeysThread;
     SaveChangesThread* m_saveChangesThread;
+    // Trace file path from environment, trace is written to it on exit
+    QString m_envTracePath;
+    // DS3 character offsets by save id, slots are rescanned only when they change
+    mutable std::mutex m_ds3OffsetCachesMutex;
+    mutable std::unordered_map<QString, std::unique_ptr<fssm::parse::ds3::InitialOffsetCache>> m_ds3OffsetCaches;
 };
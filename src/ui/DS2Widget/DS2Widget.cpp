@@ -11,7 +11,9 @@ DS2Widget::DS2Widget(Controller* controller, const QString& saveId, QWidget* par
 {
     setAttribute(Qt::WA_TranslucentBackground, true);
 
-    m_bgPix = QPixmap(":/ds2_images/bg");
+    setBackgroundRenderer([bg = QImage(":/ds2_images/bg")](const QSize& size, qreal devicePixelRatio) {
+        return renderCoverBackground(bg, size, devicePixelRatio, QColor(6, 5, 7), Qt::AlignCenter);
+    });
 
     ManageBackupsButtonsWidget* manageBackupsBtnsWidget = new ManageBackupsButtonsWidget(controller, this);
 
@@ -31,18 +33,4 @@ DS2Widget::DS2Widget(Controller* controller, const QString& saveId, QWidget* par
 
 void DS2Widget::refresh() {
     // TODO implement
-}
-
-void DS2Widget::paintEvent(QPaintEvent* event) {
-    QPainter painter = QPainter(this);
-    painter.setClipRect(event->rect());
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(6, 5, 7));
-    const QRect targetRect = rect();
-    painter.drawRect(targetRect);
-    QPixmap scaled = m_bgPix.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    // center vertically
-    const int x = (width() - scaled.width()) / 2;
-    const int y = (height() - scaled.height()) / 2;
-    painter.drawPixmap(x, y, scaled);
 }
\ No newline at end of file
@@ -6,8 +6,4 @@ class DS2Widget: public BaseGameWidget {
 public:
     explicit DS2Widget(Controller* controller, const QString& saveId, QWidget* parent);
     void refresh() override;
-protected:
-    void paintEvent(QPaintEvent* event) override;
-private:
-    QPixmap m_bgPix;
 };
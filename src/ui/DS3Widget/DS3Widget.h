@@ -21,10 +21,16 @@ signals:
 public:
     explicit CharsListModel(Controller* controller, const QString& saveId, QObject* parent);
     void refresh();
-    fssm::parse::ds3::DS3CharacterInfo* getCharByIdx(const int& index);
+    const fssm::parse::ds3::DS3CharacterInfo* getCharByIdx(const int& index) const;
+    // Character in slot was added, removed or changed by last refresh
+    bool isCharChanged(const int& index) const;
 private:
-    std::vector<fssm::parse::ds3::DS3CharacterInfo> m_chars;
-    std::array<QStandardItem*, 10> m_items;
+    void setItemName(const int& index, const QString& name);
+    // Characters by slot index, unchanged characters are kept on refresh so pointers to them stay valid
+    // - point into shared save snapshot, snapshot is freed when none of its characters is kept
+    std::array<std::shared_ptr<const fssm::parse::ds3::DS3CharacterInfo>, 10> m_chars;
+    std::array<bool, 10> m_changedChars{};
+    bool m_hasError = false;
     QString m_saveId;
     Controller* m_controller;
 };
@@ -35,13 +41,10 @@ class DS3Widget: public BaseGameWidget {
 public:
     explicit DS3Widget(Controller* controller, const QString& saveId, QWidget* parent);
     void refresh() override;
-protected:
-    void paintEvent(QPaintEvent* event) override;
 private slots:
     void onRefresh();
     void onSelectionChange(const QItemSelection &selected, const QItemSelection &deselected);
 private:
-    QPixmap m_bgPix;
     fssm::ui::ds3::CharsListModel* m_model;
     QListView* m_view;
     TabWidget* m_charTabs;
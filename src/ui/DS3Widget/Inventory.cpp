@@ -1,16 +1,18 @@
 #include "Inventory.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QPainter>
 #include <QListView>
 #include <QScrollBar>
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QVariantAnimation>
 
+#include "../PixmapCache.h"
 #include "../Utils.h"
 #include "../../parse/Parse.h"
+#include "../../parse/Trace.h"
 
 namespace {
     enum class FlaskIconType {
@@ -114,7 +116,7 @@ namespace {
         }
     }
 
-    constexpr bool isMergable(fssm::parse::ds3::InventoryItem& invItem) {
+    constexpr bool isMergable(const fssm::parse::ds3::InventoryItem& invItem) {
         switch (invItem.baseItem.category) {
             case fssm::parse::ds3::ItemCategory::Tools:
             case fssm::parse::ds3::ItemCategory::Materials:
@@ -129,62 +131,55 @@ namespace {
 
 namespace fssm::ui::ds3 {
 
-InventoryModel::InventoryModel(QObject* parent): QStandardItemModel(parent) {}
+static QString getItemImage(const std::string_view& image) {
+    if (!inventoryResourcesAvailable() || image.empty()) return QString{};
 
-void InventoryModel::setCharacter(const fssm::parse::ds3::DS3CharacterInfo* charInfo) {
-    QStandardItem* rootItem = invisibleRootItem();
-    rootItem->removeRows(0, rootItem->rowCount());
-    if (charInfo == nullptr) return;
-
-    std::unordered_map<uint32_t, QStandardItem*> itemsById;
-    QList<QStandardItem*> newItems;
-    std::vector<fssm::parse::ds3::InventoryItem*> inventoryItems;
-    for (auto invItem: charInfo->inventoryItems) {
-        // TODO find out if '1073741918' is in key items or in inventory items
-        if (invItem.itemId == 1073741918) continue;
-        QStandardItem* item = createModelItem(charInfo, invItem);
-        item->setData(invItem.amount, ItemAmountRole);
-        newItems.push_back(item);
-        if (isMergable(invItem)) itemsById[invItem.itemId] = item;
-    }
+    QString imagePath = QString::fromStdString(":/ds3_inv_images/");
+    imagePath.append(QString::fromStdString(image.data()));
+    return imagePath;
+}
 
-    for (auto invItem: charInfo->keyItems) {
-        if (invItem.itemId == 1073741918) continue;
-        QStandardItem* item = createModelItem(charInfo, invItem);
-        item->setData(invItem.amount, ItemAmountRole);
-        newItems.push_back(item);
-        if (isMergable(invItem)) itemsById[invItem.itemId] = item;
-    }
+static std::string_view getImageName(const parse::ds3::DS3CharacterInfo* charInfo, const parse::ds3::InventoryItem& invItem) {
+    if (1073741974 <= invItem.itemId && invItem.itemId <= 1073741995) {
+        switch (mapFlaskAmounts(charInfo->estusMax, invItem.amount)) {
+            case FlaskIconType::Empty:
+                return "estus_flask_empty";
+            case FlaskIconType::Half:
+                return "estus_flask_half";
+            case FlaskIconType::Quarter:
+                return "estus_flask_quater";
+            default:
+                break;
+        }
 
-    for (auto invItem: charInfo->storageBoxItems) {
-        QStandardItem* item;
-        auto it = itemsById.find(invItem.itemId);
-        if (it != itemsById.end()) {
-            item = it->second;
-        } else {
-            item = createModelItem(charInfo, invItem);
-            newItems.push_back(item);
+    } else if (1073742014 <= invItem.itemId && invItem.itemId <= 1073742033) {
+        switch (mapFlaskAmounts(charInfo->ashenEstusMax, invItem.amount)) {
+            case FlaskIconType::Empty:
+                return "ashen_estus_flask_empty";
+            case FlaskIconType::Half:
+                return "ashen_estus_flask_half";
+            case FlaskIconType::Quarter:
+                return "ashen_estus_flask_quater";
+            default:
+                break;
         }
-        item->setData(invItem.amount, ItemStorageBoxAmountRole);
     }
-    if (!newItems.isEmpty())
-        rootItem->appendRows(newItems);
-}
-
-static QPixmap getItemImage(const std::string_view& image) {
-    if (!inventoryResourcesAvailable()) return QPixmap{};
-
-    QString imagePath = QString::fromStdString(":/ds3_inv_images/");
-    imagePath.append(QString::fromStdString(image.data()));
-    return QPixmap(imagePath);
+    return invItem.baseItem.image;
 }
 
-QStandardItem* InventoryModel::createModelItem(const parse::ds3::DS3CharacterInfo* charInfo, parse::ds3::InventoryItem& invItem) {
-    if (invItem.baseItem.id == 0) return createUnknownItem(invItem);
+static QString getItemLabel(const parse::ds3::InventoryItem& invItem) {
+    if (invItem.baseItem.id == 0) {
+        QString label;
+        label.push_back("NA ");
+        label.push_back(QString::fromStdString(std::to_string(invItem.itemId)));
+        if (invItem.upgradeLevel > 0) {
+            label.push_back(" + ");
+            label.push_back(QString::number(invItem.upgradeLevel));
+        }
+        return label;
+    }
 
     std::string_view infusionName = getInfusionName(invItem.infusion);
-    QPixmap infusionImage = getItemImage(infusionName);
-
     QString label = invItem.baseItem.label.data();
     if (!infusionName.empty()) {
         std::string tmpName = infusionName.data();
@@ -201,127 +196,155 @@ QStandardItem* InventoryModel::createModelItem(const parse::ds3::DS3CharacterInf
         label.append(" + ");
         label.append(QString::number(invItem.upgradeLevel));
     }
+    return label;
+}
 
-    std::string_view imageName = invItem.baseItem.image;
-    if (1073741974 <= invItem.itemId && invItem.itemId <= 1073741995) {
-        switch (mapFlaskAmounts(charInfo->estusMax, invItem.amount)) {
-            case FlaskIconType::Empty:
-                imageName = "estus_flask_empty";
-                break;
-            case FlaskIconType::Half:
-                imageName = "estus_flask_half";
-                break;
-            case FlaskIconType::Quarter:
-                imageName = "estus_flask_quater";
-                break;
+static int getItemOrder(const parse::ds3::InventoryItem& invItem) {
+    if (invItem.baseItem.id == 0) return -1;
+    return invItem.baseItem.order;
+}
+
+InventoryModel::InventoryModel(QObject* parent): QAbstractListModel(parent) {}
+
+void InventoryModel::setCharacter(const fssm::parse::ds3::DS3CharacterInfo* charInfo) {
+    FSSM_TRACE_SCOPE("ui.ds3.inventory_model");
+    beginResetModel();
+    // Vectors are cleared to keep their capacity for next character
+    m_rows.clear();
+    m_mergeIndex.clear();
+    m_charInfo = charInfo;
+    if (charInfo != nullptr) {
+        m_rows.reserve(
+            charInfo->inventoryItems.size()
+            + charInfo->keyItems.size()
+            + charInfo->storageBoxItems.size()
+        );
+        for (const auto* items: {&charInfo->inventoryItems, &charInfo->keyItems}) {
+            for (const auto& invItem: *items) {
+                // TODO find out if '1073741918' is in key items or in inventory items
+                if (invItem.itemId == 1073741918) continue;
+                if (isMergable(invItem)) addMergeIndex(invItem.itemId, m_rows.size());
+                m_rows.push_back({&invItem, invItem.amount, 0});
+            }
         }
 
-    } else if (1073742014 <= invItem.itemId && invItem.itemId <= 1073742033) {
-        switch (mapFlaskAmounts(charInfo->ashenEstusMax, invItem.amount)) {
-            case FlaskIconType::Empty:
-                imageName = "ashen_estus_flask_empty";
-                break;
-            case FlaskIconType::Half:
-                imageName = "ashen_estus_flask_half";
-                break;
-            case FlaskIconType::Quarter:
-                imageName = "ashen_estus_flask_quater";
-                break;
+        for (const auto& invItem: charInfo->storageBoxItems) {
+            auto it = findMergeIndex(invItem.itemId);
+            if (it != m_mergeIndex.end() && it->first == invItem.itemId) {
+                m_rows[it->second].storageBoxAmount = invItem.amount;
+                continue;
+            }
+            m_rows.push_back({&invItem, 0, invItem.amount});
         }
     }
-    QPixmap itemImage = getItemImage(imageName);
-
-    QStandardItem* item = new QStandardItem(label);
-    item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-
-    item->setData(infusionImage, ItemInfusionIconRole);
-    item->setData(invItem.baseItem.order, ItemOrderRole);
-    item->setData(0, ItemAmountRole);
-    item->setData(0, ItemStorageBoxAmountRole);
-    item->setData(itemImage, ItemImageRole);
-    item->setData(QVariant::fromValue(invItem.baseItem.category), ItemCategoryRole);
-    return item;
-}
 
-QStandardItem* InventoryModel::createUnknownItem(fssm::parse::ds3::InventoryItem& inventoryItem) {
-    QStandardItem* item = new QStandardItem();
-    QString label;
-    label.push_back("NA ");
-    label.push_back(QString::fromStdString(std::to_string(inventoryItem.itemId)));
-    if (inventoryItem.upgradeLevel > 0) {
-        label.push_back(" + ");
-        label.push_back(QString::number(inventoryItem.upgradeLevel));
+    for (auto& [category, rowIdxs]: m_categoryRows) rowIdxs.clear();
+    for (size_t rowIdx = 0; rowIdx < m_rows.size(); ++rowIdx) {
+        m_categoryRows[m_rows[rowIdx].item->baseItem.category].push_back(rowIdx);
+    }
+    // Sort once by item order, labels are compared only for items with same order
+    for (auto& [category, rowIdxs]: m_categoryRows) {
+        std::sort(rowIdxs.begin(), rowIdxs.end(), [this](const size_t& left, const size_t& right) {
+            const parse::ds3::InventoryItem& leftItem = *m_rows[left].item;
+            const parse::ds3::InventoryItem& rightItem = *m_rows[right].item;
+            int leftOrder = getItemOrder(leftItem);
+            int rightOrder = getItemOrder(rightItem);
+            if (leftOrder != rightOrder) return leftOrder < rightOrder;
+            int labelCmp = getItemLabel(leftItem).compare(getItemLabel(rightItem), Qt::CaseInsensitive);
+            if (labelCmp != 0) return labelCmp < 0;
+            return left < right;
+        });
     }
-    item->setText(label);
-
-    item->setData(0, ItemStorageBoxAmountRole);
-    item->setData(-1, ItemOrderRole);
-    item->setData(inventoryItem.amount, ItemAmountRole);
-    item->setData(QVariant::fromValue(inventoryItem.baseItem.category), ItemCategoryRole);
-    item->setData(QPixmap(":/ds3_images/unknown.png"), ItemImageRole);
-    return item;
+    m_visibleRows = &m_categoryRows[m_category];
+    endResetModel();
 }
 
-InventoryProxyModel::InventoryProxyModel(QObject *parent): QSortFilterProxyModel(parent) {
-    setSortCaseSensitivity(Qt::CaseInsensitive);
-    setFilterCaseSensitivity(Qt::CaseInsensitive);
+void InventoryModel::setCategory(parse::ds3::ItemCategory category) {
+    if (category == m_category && m_visibleRows != nullptr) return;
+    beginResetModel();
+    m_category = category;
+    m_visibleRows = &m_categoryRows[m_category];
+    endResetModel();
 }
 
-void InventoryProxyModel::setCategory(parse::ds3::ItemCategory category) {
-    if (category == m_category) return;
-    beginFilterChange();
-    m_category = category;
-    endFilterChange(Direction::Rows);
+int InventoryModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || m_visibleRows == nullptr) return 0;
+    return static_cast<int>(m_visibleRows->size());
 }
 
-bool InventoryProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const {
-    int left = sourceLeft.data(ItemOrderRole).toInt();
-    int right = sourceRight.data(ItemOrderRole).toInt();
-    if (left != right) return left < right;
-    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+Qt::ItemFlags InventoryModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
 }
 
-bool InventoryProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const {
-    QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
-    parse::ds3::ItemCategory category = index.data(ItemCategoryRole).value<parse::ds3::ItemCategory>();
-    return category == m_category;
+QVariant InventoryModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || m_visibleRows == nullptr || index.row() >= static_cast<int>(m_visibleRows->size()))
+        return QVariant();
+    const InventoryRow& row = m_rows[(*m_visibleRows)[index.row()]];
+    const fssm::parse::ds3::InventoryItem& invItem = *row.item;
+    const bool knownItem = invItem.baseItem.id != 0;
+    switch (role) {
+        case Qt::DisplayRole:
+            return getItemLabel(invItem);
+        case ItemInfusionIconRole:
+            if (!knownItem) return QVariant();
+            return getItemImage(getInfusionName(invItem.infusion));
+        case ItemOrderRole:
+            return getItemOrder(invItem);
+        case ItemAmountRole:
+            return row.amount;
+        case ItemStorageBoxAmountRole:
+            return row.storageBoxAmount;
+        case ItemImageRole:
+            if (!knownItem) return QString(":/ds3_images/unknown.png");
+            return getItemImage(getImageName(m_charInfo, invItem));
+        case ItemCategoryRole:
+            return QVariant::fromValue(invItem.baseItem.category);
+        default:
+            return QVariant();
+    }
 }
 
-InventoryDelegate::InventoryDelegate(QObject* parent): QStyledItemDelegate(parent) {
-    m_standPix = QPixmap(":/ds3_images/dish");
-    m_inventoryBagPix = QPixmap(":/ds3_images/menu_invetory");
-    m_bottomlessBoxPix = QPixmap(":/ds3_images/menu_storage_box");
+std::vector<std::pair<uint32_t, size_t>>::iterator InventoryModel::findMergeIndex(const uint32_t& itemId) {
+    return std::lower_bound(
+        m_mergeIndex.begin(),
+        m_mergeIndex.end(),
+        itemId,
+        [](const std::pair<uint32_t, size_t>& item, const uint32_t& value) { return item.first < value; }
+    );
 }
 
+void InventoryModel::addMergeIndex(const uint32_t& itemId, const size_t& rowIdx) {
+    auto it = findMergeIndex(itemId);
+    if (it != m_mergeIndex.end() && it->first == itemId) {
+        it->second = rowIdx;
+        return;
+    }
+    m_mergeIndex.insert(it, {itemId, rowIdx});
+}
+
+InventoryDelegate::InventoryDelegate(QObject* parent): QStyledItemDelegate(parent) {}
+
 int InventoryDelegate::paintIcon(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
     int textOffset = 20;
     if (!inventoryResourcesAvailable()) return textOffset;
 
-    QVariant pixmapValue = index.data(ItemImageRole);
-    QPixmap pixmap;
-    if (pixmapValue.isValid() && !pixmapValue.isNull()) {
-        switch (pixmapValue.userType()) {
-            case QMetaType::QPixmap:
-                pixmap = qvariant_cast<QPixmap>(pixmapValue);
-                break;
-            default:
-                break;
-        }
-    }
-    if (pixmap.isNull())
-        pixmap = QPixmap(":/ds3_images/test_data");
+    ScaledPixmapCache* pixCache = ScaledPixmapCache::instance();
+    const qreal dpr = painter->device()->devicePixelRatioF();
+
+    QString imagePath = index.data(ItemImageRole).toString();
+    if (imagePath.isEmpty())
+        imagePath = ":/ds3_images/test_data";
     int imgSize = option.rect.height();
-    pixmap = pixmap.scaled(
-        imgSize, imgSize,
-        Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
-    QPixmap standPix = m_standPix.scaled(
-        pixmap.width(), pixmap.width(),
-        Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
+    bool pending = false;
+    QPixmap pixmap = pixCache->getAsync(imagePath, QSize(imgSize, imgSize), dpr, Qt::KeepAspectRatio, &pending);
+    // Item image is decoded in background, only the dish is painted until it is available
+    if (pixmap.isNull() && !pending)
+        pixmap = pixCache->get(":/ds3_images/test_data", QSize(imgSize, imgSize), dpr);
+    const QSize pixSize = pixmap.isNull() ? QSize(imgSize, imgSize) : pixmap.deviceIndependentSize().toSize();
 
     QRect iconRect = option.rect;
-    iconRect.setWidth(pixmap.width());
+    iconRect.setWidth(pixSize.width());
     textOffset += iconRect.right();
 
     int stand_height = 21;
@@ -331,28 +354,23 @@ int InventoryDelegate::paintIcon(QPainter* painter, const QStyleOptionViewItem&
         iconRect.width() - 20,
         stand_height
     );
+    QPixmap standPix = pixCache->get(":/ds3_images/dish", standRect.size(), dpr, Qt::IgnoreAspectRatio);
 
     painter->drawPixmap(standRect, standPix);
-    painter->drawPixmap(iconRect, pixmap);
+    if (!pixmap.isNull())
+        painter->drawPixmap(iconRect, pixmap);
 
-    QVariant infusionIconValue = index.data(ItemInfusionIconRole);
-    QPixmap infusionIcon;
-    if (infusionIconValue.isValid()) {
-        infusionIcon = qvariant_cast<QPixmap>(infusionIconValue);
-    }
-    if (!infusionIcon.isNull()) {
+    QString infusionPath = index.data(ItemInfusionIconRole).toString();
+    if (!infusionPath.isEmpty()) {
         int infusionSize = int(option.rect.height() * 0.3);
-        infusionIcon = infusionIcon.scaled(
-            infusionSize,
-            infusionSize,
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation
-        );
+        QPixmap infusionIcon = pixCache->getAsync(infusionPath, QSize(infusionSize, infusionSize), dpr);
+        if (infusionIcon.isNull()) return textOffset;
+        const QSize infusionIconSize = infusionIcon.deviceIndependentSize().toSize();
         QRect infusionRect = QRect(
-            iconRect.right() - infusionIcon.width(),
-            (iconRect.bottom() - infusionIcon.height()) - 5,
-            infusionIcon.width(),
-            infusionIcon.height()
+            iconRect.right() - infusionIconSize.width(),
+            (iconRect.bottom() - infusionIconSize.height()) - 5,
+            infusionIconSize.width(),
+            infusionIconSize.height()
         );
         painter->drawPixmap(infusionRect, infusionIcon);
     }
@@ -360,6 +378,7 @@ int InventoryDelegate::paintIcon(QPainter* painter, const QStyleOptionViewItem&
 }
 
 void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    FSSM_TRACE_SCOPE("ui.ds3.inventory_paint");
     QStyleOptionViewItem opt = option;
     initStyleOption(&opt, index);
     const QStyle* style = (option.widget ? option.widget->style() : QApplication::style())->proxy();
@@ -386,19 +405,17 @@ void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opt
 
     painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, label);
 
-    QPixmap invBagPix = m_inventoryBagPix.scaled(
-        textHeight, textHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
-    QPixmap btbPix = m_bottomlessBoxPix.scaled(
-        textHeight, textHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
+    ScaledPixmapCache* pixCache = ScaledPixmapCache::instance();
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    QPixmap invBagPix = pixCache->get(":/ds3_images/menu_invetory", QSize(textHeight, textHeight), dpr);
+    QPixmap btbPix = pixCache->get(":/ds3_images/menu_storage_box", QSize(textHeight, textHeight), dpr);
 
     QString amountText = QString::number(index.data(ItemAmountRole).toInt());
     QString bottomlessBoxText = QString::number(index.data(ItemStorageBoxAmountRole).toInt());
 
     QPoint pos = QPoint(textRect.x(), option.rect.top() + halfHeight + 10);
     painter->drawPixmap(pos, invBagPix);
-    pos.setX(pos.x() + invBagPix.width() + 2);
+    pos.setX(pos.x() + invBagPix.deviceIndependentSize().toSize().width() + 2);
 
     QRect amountRect = fm.boundingRect("9999");
     amountRect.moveTopLeft(pos);
@@ -406,7 +423,7 @@ void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opt
     pos.setX(pos.x() + amountRect.width() + 5);
 
     painter->drawPixmap(pos, btbPix);
-    pos.setX(pos.x() + btbPix.width() + 2);
+    pos.setX(pos.x() + btbPix.deviceIndependentSize().toSize().width() + 2);
 
     amountRect.moveLeft(pos.x());
     painter->drawText(amountRect, Qt::AlignLeft | Qt::AlignVCenter, bottomlessBoxText);
@@ -528,9 +545,7 @@ InventoryWidget::InventoryWidget(QWidget* parent): QWidget(parent) {
     m_delegate = new InventoryDelegate(this);
     m_view->setItemDelegate(m_delegate);
     m_model = new InventoryModel(this);
-    m_proxy = new InventoryProxyModel(this);
-    m_proxy->setSourceModel(m_model);
-    m_view->setModel(m_proxy);
+    m_view->setModel(m_model);
 
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
@@ -539,15 +554,27 @@ InventoryWidget::InventoryWidget(QWidget* parent): QWidget(parent) {
 
     connect(m_categoryBtns, SIGNAL(categoryChanged(parse::ds3::ItemCategory)), this, SLOT(onCategoryChange(parse::ds3::ItemCategory)));
 
-    m_proxy->setCategory(m_categoryBtns->getCategory());
+    m_model->setCategory(m_categoryBtns->getCategory());
 }
 
 void InventoryWidget::setCharacter(const fssm::parse::ds3::DS3CharacterInfo* charInfo) {
     m_model->setCharacter(charInfo);
-    m_proxy->sort(0, Qt::AscendingOrder);
+}
+
+// Repaint visible rows when icons decoded in background are available, hidden
+//   inventories of other games or tabs are not repainted
+void InventoryWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    connect(ScaledPixmapCache::instance(), SIGNAL(pixmapLoaded()), m_view->viewport(), SLOT(update()), Qt::UniqueConnection);
+    m_view->viewport()->update();
+}
+
+void InventoryWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    disconnect(ScaledPixmapCache::instance(), SIGNAL(pixmapLoaded()), m_view->viewport(), SLOT(update()));
 }
 
 void InventoryWidget::onCategoryChange(parse::ds3::ItemCategory category) {
-    m_proxy->setCategory(category);
+    m_model->setCategory(category);
 }
 }
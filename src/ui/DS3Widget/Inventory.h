@@ -1,9 +1,9 @@
 #pragma once
+#include <QAbstractListModel>
 #include <QListView>
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QVariantAnimation>
+#include <unordered_map>
 
 #include "../Utils.h"
 #include "../../parse/Parse.h"
@@ -18,24 +18,34 @@ const int ItemStorageBoxAmountRole = Qt::UserRole + 6;
 const int ItemImageRole = Qt::UserRole + 7;
 const int ItemCategoryRole = Qt::UserRole + 8;
 
-class InventoryModel: public QStandardItemModel {
-    Q_OBJECT
-public:
-    explicit InventoryModel(QObject* parent = nullptr);
-    void setCharacter(const parse::ds3::DS3CharacterInfo* charInfo);
-private:
-    QStandardItem* createModelItem(const parse::ds3::DS3CharacterInfo* charInfo, parse::ds3::InventoryItem& inventoryItem);
-    QStandardItem* createUnknownItem(parse::ds3::InventoryItem& inventoryItem);
+// Row of inventory view, inventory and storage box items may be merged to one row
+struct InventoryRow {
+    const parse::ds3::InventoryItem* item;
+    uint32_t amount;
+    uint32_t storageBoxAmount;
 };
 
-class InventoryProxyModel: public QSortFilterProxyModel {
+// Model showing items of character directly, character info must outlive the model or be unset
+class InventoryModel: public QAbstractListModel {
     Q_OBJECT
 public:
-    explicit InventoryProxyModel(QObject *parent = nullptr);
+    explicit InventoryModel(QObject* parent = nullptr);
+    void setCharacter(const parse::ds3::DS3CharacterInfo* charInfo);
     void setCategory(parse::ds3::ItemCategory category);
-    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
-    bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
 private:
+    std::vector<std::pair<uint32_t, size_t>>::iterator findMergeIndex(const uint32_t& itemId);
+    void addMergeIndex(const uint32_t& itemId, const size_t& rowIdx);
+
+    const parse::ds3::DS3CharacterInfo* m_charInfo = nullptr;
+    std::vector<InventoryRow> m_rows;
+    // Sorted pairs of item id and row index of mergeable items
+    std::vector<std::pair<uint32_t, size_t>> m_mergeIndex;
+    // Row indexes per category sorted by item order, filled once per character
+    std::unordered_map<parse::ds3::ItemCategory, std::vector<size_t>> m_categoryRows;
+    const std::vector<size_t>* m_visibleRows = nullptr;
     parse::ds3::ItemCategory m_category = parse::ds3::ItemCategory::Tools;
 };
 
@@ -46,9 +56,6 @@ public:
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
     QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 private:
-    QPixmap m_standPix;
-    QPixmap m_inventoryBagPix;
-    QPixmap m_bottomlessBoxPix;
     int paintIcon(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
 };
 
@@ -94,13 +101,15 @@ class InventoryWidget: public QWidget {
 public:
     explicit InventoryWidget(QWidget* parent);
     void setCharacter(const parse::ds3::DS3CharacterInfo* charInfo);
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 private slots:
     void onCategoryChange(parse::ds3::ItemCategory category);
 private:
     CategoryButtons* m_categoryBtns = nullptr;
     QListView* m_view = nullptr;
     InventoryModel* m_model = nullptr;
-    InventoryProxyModel* m_proxy = nullptr;
     InventoryDelegate* m_delegate = nullptr;
 };
 }
@@ -5,6 +5,7 @@
 #include <QPainter>
 
 #include "../ManageBackupsWidget.h"
+#include "../../parse/Metrics.h"
 
 namespace fssm::ui::dsr {
 CharsListModel::CharsListModel(Controller* controller, const QString& saveId, QObject* parent)
@@ -24,12 +25,15 @@ CharsListModel::CharsListModel(Controller* controller, const QString& saveId, QO
 }
 
 void CharsListModel::refresh() {
-    // TODO capture error and use it in first item (NoFlags)
     QStandardItem* root = invisibleRootItem();
 
     DSRCharInfoResult charsInfo = m_controller->getDsrCharacters(m_saveId);
     if (!charsInfo.error.isEmpty()) {
-        m_chars = std::vector<fssm::parse::dsr::DSRCharacterInfo>();
+        for (int i = 0; i < 10; ++i) {
+            m_changedChars[i] = m_chars[i] != nullptr;
+            m_chars[i].reset();
+        }
+        m_hasError = true;
         QStandardItem* item = root->child(0);
         item->setText(charsInfo.error);
         for (int i = 1; i < root->rowCount(); ++i) {
@@ -40,37 +44,70 @@ void CharsListModel::refresh() {
         emit refreshed();
         return;
     }
-    m_chars = charsInfo.characters;
-    for (int i = 0; i < root->rowCount(); ++i) {
-        QStandardItem* item = root->child(i);
-        bool found = false;
-        for (auto& character: m_chars) {
-            if (i == character.index) {
-                item->setText(QString::fromStdU16String(character.name));
-                item->setData(QString::fromStdU16String(character.name), CharNameRole);
-                found = true;
-                break;
-            }
+
+    // Compare with previous state by checksum of slot entry, only changed rows are updated
+    std::array<bool, 10> foundChars{};
+    const auto& saveFile = charsInfo.saveFile;
+    for (const auto& character: saveFile->characters) {
+        if (character.index < 0 || character.index >= 10) continue;
+        foundChars[character.index] = true;
+        std::shared_ptr<const fssm::parse::dsr::DSRCharacterInfo>& current = m_chars[character.index];
+        const bool changed = (
+            !current
+            || current->checksum != character.checksum
+            || current->name != character.name
+        );
+        m_changedChars[character.index] = changed;
+        fssm::metrics::counter(changed ? "cache.characters.misses" : "cache.characters.hits").add();
+        // Aliasing pointer shares ownership of the whole snapshot, character is not copied
+        if (changed) current = std::shared_ptr<const fssm::parse::dsr::DSRCharacterInfo>(saveFile, &character);
+    }
+    for (int i = 0; i < 10; ++i) {
+        if (foundChars[i]) continue;
+        m_changedChars[i] = m_chars[i] != nullptr;
+        m_chars[i].reset();
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        if (!m_hasError && !m_changedChars[i]) continue;
+        if (m_chars[i]) {
+            setItemName(i, QString::fromStdU16String(m_chars[i]->name));
+        } else {
+            setItemName(i, QString{});
         }
-        if (found) continue;
-        item->setText("< Empty >");
-        item->setData(QVariant(), CharNameRole);
     }
+    m_hasError = false;
     emit refreshed();
 };
 
-fssm::parse::dsr::DSRCharacterInfo* CharsListModel::getCharByIdx(const int& index) {
-    for (auto& character: m_chars) {
-        if (character.index == index) return &character;
+void CharsListModel::setItemName(const int& index, const QString& name) {
+    QStandardItem* item = invisibleRootItem()->child(index);
+    if (name.isNull()) {
+        item->setText("< Empty >");
+        item->setData(QVariant(), CharNameRole);
+        return;
     }
-    return nullptr;
+    item->setText(name);
+    item->setData(name, CharNameRole);
+}
+
+const fssm::parse::dsr::DSRCharacterInfo* CharsListModel::getCharByIdx(const int& index) const {
+    if (index < 0 || index >= 10) return nullptr;
+    return m_chars[index].get();
+}
+
+bool CharsListModel::isCharChanged(const int& index) const {
+    if (index < 0 || index >= 10) return false;
+    return m_changedChars[index];
 }
 }
 
 DSRWidget::DSRWidget(Controller* controller, const QString& saveId, QWidget* parent)
     : BaseGameWidget(controller, saveId, parent)
 {
-    m_bgPix = QPixmap(":/dsr_images/bg");
+    setBackgroundRenderer([bg = QImage(":/dsr_images/bg")](const QSize& size, qreal devicePixelRatio) {
+        return renderCoverBackground(bg, size, devicePixelRatio, QColor(6, 5, 7), Qt::AlignLeft | Qt::AlignVCenter);
+    });
 
     QWidget* viewWrap = new QWidget(this);
     viewWrap->setAttribute(Qt::WA_TranslucentBackground, true);
@@ -130,41 +167,14 @@ void DSRWidget::refresh() {
     m_model->refresh();
 };
 
-void DSRWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter = QPainter(this);
-    painter.setClipRect(event->rect());
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(6, 5, 7));
-    const QRect targetRect = rect();
-    painter.drawRect(targetRect);
-    QPixmap scaled = m_bgPix.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    // center vertically
-    const int y = (height() - scaled.height()) / 2;
-    painter.drawPixmap(0, y, scaled);
-    // --- Manual approach ---
-    // const double sAspect = double(pix.width()) / pix.height();
-    // const double tAspect = double(targetRect.width()) / targetRect.height();
-    // int posY = 0;
-    // int srcWidth = pix.width();
-    // int srcHeight = pix.height();
-    // if (tAspect > sAspect) {
-    //     // Crop vertically in source and offset y position
-    //     srcHeight = int(pix.width() / tAspect);
-    //     posY = (pix.height() - srcHeight) / 2;
-    // } else {
-    //     // Crop horizontally in source
-    //     srcWidth = int(pix.height() * tAspect);
-    // }
-    // QRect src = QRect(0, posY, srcWidth, srcHeight);
-    // painter.drawPixmap(targetRect, pix, src);
-};
-
 void DSRWidget::onRefresh() {
     QItemSelectionModel* selModel = m_view->selectionModel();
     for (auto& index: selModel->selectedIndexes()) {
         QVariant charId = index.data(fssm::ui::dsr::CharIdRole);
         if (!charId.isValid() || charId.isNull()) continue;
-        fssm::parse::dsr::DSRCharacterInfo* charInfo = m_model->getCharByIdx(charId.toInt());
+        // Panes are rebuilt only if selected character did change
+        if (!m_model->isCharChanged(charId.toInt())) return;
+        const fssm::parse::dsr::DSRCharacterInfo* charInfo = m_model->getCharByIdx(charId.toInt());
         m_charInfoWidget->setCharacter(charInfo);
         m_inventoryWidget->setCharacter(charInfo);
         m_covenantsWidget->setCharacter(charInfo);
@@ -1,243 +1,270 @@
 #include "Inventory.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QPainter>
 #include <QListView>
 #include <QScrollBar>
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QVariantAnimation>
 
+#include "../PixmapCache.h"
 #include "../Utils.h"
 #include "../../parse/Parse.h"
+#include "../../parse/Trace.h"
 
 namespace fssm::ui::dsr {
-InventoryModel::InventoryModel(QObject* parent): QStandardItemModel(parent) {}
-
-void InventoryModel::setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo) {
-    QStandardItem* rootItem = invisibleRootItem();
-    rootItem->removeRows(0, rootItem->rowCount());
-    if (charInfo == nullptr) return;
-
-    std::unordered_map<uint32_t, QStandardItem*> itemsById;
-    QList<QStandardItem*> newItems;
-    for (auto invItem: charInfo->inventoryItems) {
-        QStandardItem* item = createModelItem(invItem);
-        if (item == nullptr) continue;
-
-        item->setData(invItem.amount, ItemAmountRole);
-        // Show consumables, materials and ammunition items from both inventory and bottomless box in one item
-        // TODO use enum for category
-        if (invItem.baseItem.category == parse::dsr::ItemCategory::Consumables || invItem.baseItem.category == parse::dsr::ItemCategory::Materials || invItem.baseItem.category == parse::dsr::ItemCategory::ArrowsBolts) {
-            itemsById[invItem.itemId] = item;
-        }
-        newItems.append(item);
-    }
-    for (auto blbItem: charInfo->bottomlessBoxItems) {
-        QStandardItem* item = nullptr;
-        if (blbItem.baseItem.category == parse::dsr::ItemCategory::Consumables || blbItem.baseItem.category == parse::dsr::ItemCategory::Materials || blbItem.baseItem.category == parse::dsr::ItemCategory::ArrowsBolts) {
-            auto iterItem = itemsById.find(blbItem.itemId);
-            if (iterItem != itemsById.end()) item = iterItem->second;
-        };
-        if (item == nullptr) {
-            item = createModelItem(blbItem);
-            if (item == nullptr) continue;
-            itemsById[blbItem.itemId] = item;
-            newItems.append(item);
-        }
-        item->setData(blbItem.amount, ItemBottomlessBoxAmountRole);
-    }
-
-    if (!newItems.isEmpty())
-        rootItem->appendRows(newItems);
-}
-
-static QPixmap getInfusionIcon(const uint16_t& infusion, const uint8_t& upgradeLevel) {
-    if (!inventoryResourcesAvailable()) return QPixmap{};
+static QString getInfusionIcon(const uint16_t& infusion, const uint8_t& upgradeLevel) {
+    if (!inventoryResourcesAvailable()) return QString{};
     switch (infusion) {
         case 100:
-            return QPixmap(":/dsr_inv_images/crystal");
+            return ":/dsr_inv_images/crystal";
         case 200:
-            return QPixmap(":/dsr_inv_images/lightning");
+            return ":/dsr_inv_images/lightning";
         case 300:
-            return QPixmap(":/dsr_inv_images/raw");
+            return ":/dsr_inv_images/raw";
         case 400:
             if (upgradeLevel >= 5)
-                return QPixmap(":/dsr_inv_images/magic_2");
-            return QPixmap(":/dsr_inv_images/magic");
+                return ":/dsr_inv_images/magic_2";
+            return ":/dsr_inv_images/magic";
         case 500:
-            return QPixmap(":/dsr_inv_images/enchanted");
+            return ":/dsr_inv_images/enchanted";
         case 600:
             if (upgradeLevel >= 5)
-                return QPixmap(":/dsr_inv_images/divine_2");
-            return QPixmap(":/dsr_inv_images/divine");
+                return ":/dsr_inv_images/divine_2";
+            return ":/dsr_inv_images/divine";
         case 700:
-            return QPixmap(":/dsr_inv_images/occult");
+            return ":/dsr_inv_images/occult";
         case 800:
             if (upgradeLevel >= 5)
-                return QPixmap(":/dsr_inv_images/fire_2");
-            return QPixmap(":/dsr_inv_images/fire");
+                return ":/dsr_inv_images/fire_2";
+            return ":/dsr_inv_images/fire";
 
         case 900:
-            return QPixmap(":/dsr_inv_images/chaos");
+            return ":/dsr_inv_images/chaos";
         default:
-            return QPixmap{};
+            return QString{};
     }
 }
 
-static QPixmap getItemImage(const std::string_view& image) {
-    if (!inventoryResourcesAvailable()) return QPixmap{};
+static QString getItemImage(const std::string_view& image) {
+    if (!inventoryResourcesAvailable()) return QString{};
 
     QString imagePath = QString::fromStdString(":/dsr_inv_images/");
     imagePath.append(QString::fromStdString(image.data()));
-    imagePath.append(QString::fromStdString(""));
-    return QPixmap(imagePath);
+    return imagePath;
+}
+
+// Show consumables, materials and ammunition items from both inventory and bottomless box in one item
+static bool isMergeable(const fssm::parse::dsr::InventoryItem& invItem) {
+    switch (invItem.baseItem.category) {
+        case parse::dsr::ItemCategory::Consumables:
+        case parse::dsr::ItemCategory::Materials:
+        case parse::dsr::ItemCategory::ArrowsBolts:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static QString getItemLabel(const fssm::parse::dsr::InventoryItem& invItem) {
+    if (!invItem.knownItem) {
+        return QString("NA %1 %2").arg(invItem.itemType).arg(invItem.itemId);
+    }
+    return QString::fromStdString(invItem.baseItem.label.data());
 }
 
-QStandardItem* InventoryModel::createModelItem(fssm::parse::dsr::InventoryItem& inventoryItem) {
-    if (!inventoryItem.knownItem) return createUnknownItem(inventoryItem);
+static int getItemOrder(const fssm::parse::dsr::InventoryItem& invItem) {
+    return invItem.order;
+}
+
+static bool isHiddenItem(const fssm::parse::dsr::InventoryItem& invItem) {
+    if (!invItem.knownItem) return false;
     // Skip fist
-    if (inventoryItem.baseItem.type == 0 && inventoryItem.baseItem.id == 900000) return nullptr;
+    if (invItem.baseItem.type == 0 && invItem.baseItem.id == 900000) return true;
     // Skip no armor
-    if (inventoryItem.baseItem.type == 268435456) {
-        switch (inventoryItem.baseItem.id) {
+    if (invItem.baseItem.type == 268435456) {
+        switch (invItem.baseItem.id) {
             case 900000:
             case 901000:
             case 902000:
             case 903000:
-                return nullptr;
+                return true;
             default:
                 break;
         }
     }
+    return false;
+}
 
-    QPixmap infusionPix = getInfusionIcon(inventoryItem.infusion, inventoryItem.upgradeLevel);
-    QPixmap itemImage = getItemImage(inventoryItem.baseItem.image);
+InventoryModel::InventoryModel(QObject* parent): QAbstractListModel(parent) {}
 
-    QStandardItem* item = new QStandardItem(QString::fromStdString(inventoryItem.baseItem.label.data()));
-    item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+void InventoryModel::setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo) {
+    FSSM_TRACE_SCOPE("ui.dsr.inventory_model");
+    beginResetModel();
+    // Vectors are cleared to keep their capacity for next character
+    m_rows.clear();
+    m_mergeIndex.clear();
+    m_charInfo = charInfo;
+    if (charInfo != nullptr) {
+        m_rows.reserve(charInfo->inventoryItems.size() + charInfo->bottomlessBoxItems.size());
+        for (const auto& invItem: charInfo->inventoryItems) {
+            if (isHiddenItem(invItem)) continue;
+            if (isMergeable(invItem)) addMergeIndex(invItem.itemId, m_rows.size());
+            m_rows.push_back({&invItem, invItem.amount, 0});
+        }
+        for (const auto& blbItem: charInfo->bottomlessBoxItems) {
+            if (isHiddenItem(blbItem)) continue;
+            if (isMergeable(blbItem)) {
+                auto it = findMergeIndex(blbItem.itemId);
+                if (it != m_mergeIndex.end() && it->first == blbItem.itemId) {
+                    m_rows[it->second].bottomlessBoxAmount = blbItem.amount;
+                    continue;
+                }
+                addMergeIndex(blbItem.itemId, m_rows.size());
+            }
+            m_rows.push_back({&blbItem, 0, blbItem.amount});
+        }
+    }
 
-    item->setData(inventoryItem.upgradeLevel, ItemLevelRole);
-    item->setData(infusionPix, ItemInfusionIconRole);
-    item->setData(inventoryItem.order, ItemOrderRole);
-    item->setData(inventoryItem.durability, ItemDurabilityRole);
-    item->setData(0, ItemAmountRole);
-    item->setData(0, ItemBottomlessBoxAmountRole);
-    item->setData(itemImage, ItemImageRole);
-    item->setData(QVariant::fromValue(inventoryItem.baseItem.category), ItemCategoryRole);
-    return item;
+    for (auto& [category, rowIdxs]: m_categoryRows) rowIdxs.clear();
+    for (size_t rowIdx = 0; rowIdx < m_rows.size(); ++rowIdx) {
+        m_categoryRows[m_rows[rowIdx].item->baseItem.category].push_back(rowIdx);
+    }
+    // Sort once by item order, labels are compared only for items with same order
+    for (auto& [category, rowIdxs]: m_categoryRows) {
+        std::sort(rowIdxs.begin(), rowIdxs.end(), [this](const size_t& left, const size_t& right) {
+            const parse::dsr::InventoryItem& leftItem = *m_rows[left].item;
+            const parse::dsr::InventoryItem& rightItem = *m_rows[right].item;
+            int leftOrder = getItemOrder(leftItem);
+            int rightOrder = getItemOrder(rightItem);
+            if (leftOrder != rightOrder) return leftOrder < rightOrder;
+            int labelCmp = getItemLabel(leftItem).compare(getItemLabel(rightItem), Qt::CaseInsensitive);
+            if (labelCmp != 0) return labelCmp < 0;
+            return left < right;
+        });
+    }
+    m_visibleRows = &m_categoryRows[m_category];
+    endResetModel();
 }
-QStandardItem* InventoryModel::createUnknownItem(fssm::parse::dsr::InventoryItem& inventoryItem) {
-    QStandardItem* item = new QStandardItem();
-    QString label;
-    label.push_back("NA ");
-    label.push_back(QString::fromStdString(std::to_string(inventoryItem.itemType)));
-    label.push_back(" ");
-    label.push_back(QString::fromStdString(std::to_string(inventoryItem.itemId)));
-    item->setText(label);
 
-    item->setData(inventoryItem.upgradeLevel, ItemLevelRole);
-    item->setData(inventoryItem.order, ItemOrderRole);
-    item->setData(inventoryItem.durability, ItemDurabilityRole);
-    item->setData(QVariant::fromValue(inventoryItem.baseItem.category), ItemCategoryRole);
-    item->setData(QPixmap(":/dsr_images/unknown"), ItemImageRole);
-    return item;
+void InventoryModel::setCategory(parse::dsr::ItemCategory category) {
+    if (category == m_category && m_visibleRows != nullptr) return;
+    beginResetModel();
+    m_category = category;
+    m_visibleRows = &m_categoryRows[m_category];
+    endResetModel();
 }
 
-
-InventoryProxyModel::InventoryProxyModel(QObject *parent): QSortFilterProxyModel(parent) {
-    setSortCaseSensitivity(Qt::CaseInsensitive);
-    setFilterCaseSensitivity(Qt::CaseInsensitive);
+int InventoryModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || m_visibleRows == nullptr) return 0;
+    return static_cast<int>(m_visibleRows->size());
 }
 
-void InventoryProxyModel::setCategory(parse::dsr::ItemCategory category) {
-    if (category == m_category) return;
-    beginFilterChange();
-    m_category = category;
-    endFilterChange(Direction::Rows);
+Qt::ItemFlags InventoryModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
 }
 
-bool InventoryProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const {
-    int left = sourceLeft.data(ItemOrderRole).toInt();
-    int right = sourceRight.data(ItemOrderRole).toInt();
-    if (left != right) return left < right;
-    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+QVariant InventoryModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || m_visibleRows == nullptr || index.row() >= static_cast<int>(m_visibleRows->size()))
+        return QVariant();
+    const InventoryRow& row = m_rows[(*m_visibleRows)[index.row()]];
+    const fssm::parse::dsr::InventoryItem& invItem = *row.item;
+    switch (role) {
+        case Qt::DisplayRole:
+            return getItemLabel(invItem);
+        case ItemLevelRole:
+            return invItem.upgradeLevel;
+        case ItemInfusionIconRole:
+            if (!invItem.knownItem) return QVariant();
+            return getInfusionIcon(invItem.infusion, invItem.upgradeLevel);
+        case ItemOrderRole:
+            return getItemOrder(invItem);
+        case ItemDurabilityRole:
+            return invItem.durability;
+        case ItemAmountRole:
+            return row.amount;
+        case ItemBottomlessBoxAmountRole:
+            return row.bottomlessBoxAmount;
+        case ItemImageRole:
+            if (!invItem.knownItem) return QString(":/dsr_images/unknown");
+            return getItemImage(invItem.baseItem.image);
+        case ItemCategoryRole:
+            return QVariant::fromValue(invItem.baseItem.category);
+        default:
+            return QVariant();
+    }
 }
 
-bool InventoryProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const {
-    QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
-    parse::dsr::ItemCategory category = index.data(ItemCategoryRole).value<parse::dsr::ItemCategory>();
-    return category == m_category;
+std::vector<std::pair<uint32_t, size_t>>::iterator InventoryModel::findMergeIndex(const uint32_t& itemId) {
+    return std::lower_bound(
+        m_mergeIndex.begin(),
+        m_mergeIndex.end(),
+        itemId,
+        [](const std::pair<uint32_t, size_t>& item, const uint32_t& value) { return item.first < value; }
+    );
 }
 
-
-InventoryDelegate::InventoryDelegate(QObject* parent): QStyledItemDelegate(parent) {
-    m_standPix = QPixmap(":/dsr_images/inventory_stand");
-    m_inventoryBagPix = QPixmap(":/dsr_images/inventory_bag");
-    m_bottomlessBoxPix = QPixmap(":/dsr_images/bottomless_box");
+void InventoryModel::addMergeIndex(const uint32_t& itemId, const size_t& rowIdx) {
+    auto it = findMergeIndex(itemId);
+    if (it != m_mergeIndex.end() && it->first == itemId) {
+        it->second = rowIdx;
+        return;
+    }
+    m_mergeIndex.insert(it, {itemId, rowIdx});
 }
 
+InventoryDelegate::InventoryDelegate(QObject* parent): QStyledItemDelegate(parent) {}
+
 int InventoryDelegate::paintIcon(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
     int textOffset = 20;
     if (!inventoryResourcesAvailable()) return textOffset;
 
-    QVariant pixmapValue = index.data(ItemImageRole);
-    QPixmap pixmap;
-    if (pixmapValue.isValid() && !pixmapValue.isNull()) {
-        switch (pixmapValue.userType()) {
-            case QMetaType::QPixmap:
-                pixmap = qvariant_cast<QPixmap>(pixmapValue);
-                break;
-            default:
-                break;
-        }
-    }
-    if (pixmap.isNull())
-        pixmap = QPixmap(":/dsr_images/unknown");
+    ScaledPixmapCache* pixCache = ScaledPixmapCache::instance();
+    const qreal dpr = painter->device()->devicePixelRatioF();
+
+    QString imagePath = index.data(ItemImageRole).toString();
+    if (imagePath.isEmpty())
+        imagePath = ":/dsr_images/unknown";
     int imgSize = option.rect.height() - 20;
-    pixmap = pixmap.scaled(
-        imgSize, imgSize,
-        Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
-    QPixmap standPix = m_standPix.scaled(
-        pixmap.width(), pixmap.width(),
-        Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
+    bool pending = false;
+    QPixmap pixmap = pixCache->getAsync(imagePath, QSize(imgSize, imgSize), dpr, Qt::KeepAspectRatio, &pending);
+    // Item image is decoded in background, only the stand is painted until it is available
+    if (pixmap.isNull() && !pending)
+        pixmap = pixCache->get(":/dsr_images/unknown", QSize(imgSize, imgSize), dpr);
+    const QSize pixSize = pixmap.isNull() ? QSize(imgSize, imgSize) : pixmap.deviceIndependentSize().toSize();
+    QPixmap standPix = pixCache->get(":/dsr_images/inventory_stand", QSize(pixSize.width(), pixSize.width()), dpr);
+    const QSize standSize = standPix.deviceIndependentSize().toSize();
 
     QRect iconRect = option.rect;
-    iconRect.setWidth(pixmap.width());
+    iconRect.setWidth(pixSize.width());
     textOffset += iconRect.right();
     iconRect.adjust(10, 10, 10, -10);
 
     QRect standRect = QRect(
         iconRect.left(),
-        (iconRect.bottom() - standPix.height()) + 10,
-        standPix.width(),
-        standPix.height()
+        (iconRect.bottom() - standSize.height()) + 10,
+        standSize.width(),
+        standSize.height()
     );
 
     painter->drawPixmap(standRect, standPix);
-    painter->drawPixmap(iconRect, pixmap);
+    if (!pixmap.isNull())
+        painter->drawPixmap(iconRect, pixmap);
 
-    QVariant infusionIconValue = index.data(ItemInfusionIconRole);
-    QPixmap infusionIcon;
-    if (infusionIconValue.isValid()) {
-        infusionIcon = qvariant_cast<QPixmap>(infusionIconValue);
-    }
-    if (!infusionIcon.isNull()) {
+    QString infusionPath = index.data(ItemInfusionIconRole).toString();
+    if (!infusionPath.isEmpty()) {
         int infusionSize = int(option.rect.height() * 0.3);
-        infusionIcon = infusionIcon.scaled(
-            infusionSize,
-            infusionSize,
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation
-        );
+        QPixmap infusionIcon = pixCache->getAsync(infusionPath, QSize(infusionSize, infusionSize), dpr);
+        if (infusionIcon.isNull()) return textOffset;
+        const QSize infusionIconSize = infusionIcon.deviceIndependentSize().toSize();
         QRect infusionRect = QRect(
-            (iconRect.right() - infusionIcon.width()) + 4,
-            (iconRect.bottom() - infusionIcon.height()) + 4,
-            infusionIcon.width(),
-            infusionIcon.height()
+            (iconRect.right() - infusionIconSize.width()) + 4,
+            (iconRect.bottom() - infusionIconSize.height()) + 4,
+            infusionIconSize.width(),
+            infusionIconSize.height()
         );
         painter->drawPixmap(infusionRect, infusionIcon);
     }
@@ -245,6 +272,7 @@ int InventoryDelegate::paintIcon(QPainter* painter, const QStyleOptionViewItem&
 }
 
 void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    FSSM_TRACE_SCOPE("ui.dsr.inventory_paint");
     QStyleOptionViewItem opt = option;
     initStyleOption(&opt, index);
     const QStyle* style = (option.widget ? option.widget->style() : QApplication::style())->proxy();
@@ -277,19 +305,17 @@ void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opt
 
     painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, label);
 
-    QPixmap invBagPix = m_inventoryBagPix.scaled(
-        textHeight, textHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
-    QPixmap btbPix = m_bottomlessBoxPix.scaled(
-        textHeight, textHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
+    ScaledPixmapCache* pixCache = ScaledPixmapCache::instance();
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    QPixmap invBagPix = pixCache->get(":/dsr_images/inventory_bag", QSize(textHeight, textHeight), dpr);
+    QPixmap btbPix = pixCache->get(":/dsr_images/bottomless_box", QSize(textHeight, textHeight), dpr);
 
     QString amountText = QString::number(index.data(ItemAmountRole).toInt());
     QString bottomlessBoxText = QString::number(index.data(ItemBottomlessBoxAmountRole).toInt());
 
     QPoint pos = QPoint(textRect.x(), option.rect.top() + halfHeight + 10);
     painter->drawPixmap(pos, invBagPix);
-    pos.setX(pos.x() + invBagPix.width() + 2);
+    pos.setX(pos.x() + invBagPix.deviceIndependentSize().toSize().width() + 2);
 
     QRect amountRect = fm.boundingRect("9999");
     amountRect.moveTopLeft(pos);
@@ -297,7 +323,7 @@ void InventoryDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opt
     pos.setX(pos.x() + amountRect.width() + 5);
 
     painter->drawPixmap(pos, btbPix);
-    pos.setX(pos.x() + btbPix.width() + 2);
+    pos.setX(pos.x() + btbPix.deviceIndependentSize().toSize().width() + 2);
 
     amountRect.moveLeft(pos.x());
     painter->drawText(amountRect, Qt::AlignLeft | Qt::AlignVCenter, bottomlessBoxText);
@@ -446,9 +472,7 @@ InventoryWidget::InventoryWidget(QWidget* parent): QWidget(parent) {
     m_delegate = new InventoryDelegate(this);
     m_view->setItemDelegate(m_delegate);
     m_model = new InventoryModel(this);
-    m_proxy = new InventoryProxyModel(this);
-    m_proxy->setSourceModel(m_model);
-    m_view->setModel(m_proxy);
+    m_view->setModel(m_model);
 
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
@@ -457,15 +481,27 @@ InventoryWidget::InventoryWidget(QWidget* parent): QWidget(parent) {
 
     connect(m_categoryBtns, SIGNAL(categoryChanged(parse::dsr::ItemCategory)), this, SLOT(onCategoryChange(parse::dsr::ItemCategory)));
 
-    m_proxy->setCategory(m_categoryBtns->getCategory());
+    m_model->setCategory(m_categoryBtns->getCategory());
 }
 
 void InventoryWidget::setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo) {
     m_model->setCharacter(charInfo);
-    m_proxy->sort(0, Qt::AscendingOrder);
+}
+
+// Repaint visible rows when icons decoded in background are available, hidden
+//   inventories of other games or tabs are not repainted
+void InventoryWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    connect(ScaledPixmapCache::instance(), SIGNAL(pixmapLoaded()), m_view->viewport(), SLOT(update()), Qt::UniqueConnection);
+    m_view->viewport()->update();
+}
+
+void InventoryWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    disconnect(ScaledPixmapCache::instance(), SIGNAL(pixmapLoaded()), m_view->viewport(), SLOT(update()));
 }
 
 void InventoryWidget::onCategoryChange(parse::dsr::ItemCategory category) {
-    m_proxy->setCategory(category);
+    m_model->setCategory(category);
 }
 }
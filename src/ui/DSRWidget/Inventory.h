@@ -1,9 +1,9 @@
 #pragma once
+#include <QAbstractListModel>
 #include <QListView>
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QVariantAnimation>
+#include <unordered_map>
 
 #include "../Utils.h"
 #include "../../parse/Parse.h"
@@ -19,24 +19,34 @@ const int ItemImageRole = Qt::UserRole + 7;
 const int ItemCategoryRole = Qt::UserRole + 8;
 
 
-class InventoryModel: public QStandardItemModel {
-    Q_OBJECT
-public:
-    explicit InventoryModel(QObject* parent = nullptr);
-    void setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo);
-private:
-    QStandardItem* createModelItem(fssm::parse::dsr::InventoryItem& inventoryItem);
-    QStandardItem* createUnknownItem(fssm::parse::dsr::InventoryItem& inventoryItem);
+// Row of inventory view, inventory and bottomless box items may be merged to one row
+struct InventoryRow {
+    const fssm::parse::dsr::InventoryItem* item;
+    uint32_t amount;
+    uint32_t bottomlessBoxAmount;
 };
 
-class InventoryProxyModel: public QSortFilterProxyModel {
+// Model showing items of character directly, character info must outlive the model or be unset
+class InventoryModel: public QAbstractListModel {
     Q_OBJECT
 public:
-    explicit InventoryProxyModel(QObject *parent = nullptr);
+    explicit InventoryModel(QObject* parent = nullptr);
+    void setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo);
     void setCategory(parse::dsr::ItemCategory category);
-    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
-    bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
 private:
+    std::vector<std::pair<uint32_t, size_t>>::iterator findMergeIndex(const uint32_t& itemId);
+    void addMergeIndex(const uint32_t& itemId, const size_t& rowIdx);
+
+    const fssm::parse::dsr::DSRCharacterInfo* m_charInfo = nullptr;
+    std::vector<InventoryRow> m_rows;
+    // Sorted pairs of item id and row index of mergeable items
+    std::vector<std::pair<uint32_t, size_t>> m_mergeIndex;
+    // Row indexes per category sorted by item order, filled once per character
+    std::unordered_map<parse::dsr::ItemCategory, std::vector<size_t>> m_categoryRows;
+    const std::vector<size_t>* m_visibleRows = nullptr;
     parse::dsr::ItemCategory m_category = parse::dsr::ItemCategory::Spells;
 };
 
@@ -47,9 +57,6 @@ public:
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
     QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 private:
-    QPixmap m_standPix;
-    QPixmap m_inventoryBagPix;
-    QPixmap m_bottomlessBoxPix;
     int paintIcon(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
 };
 
@@ -109,13 +116,15 @@ class InventoryWidget: public QWidget {
 public:
     explicit InventoryWidget(QWidget* parent);
     void setCharacter(const fssm::parse::dsr::DSRCharacterInfo* charInfo);
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 private slots:
     void onCategoryChange(parse::dsr::ItemCategory category);
 private:
     CategoryButtons* m_categoryBtns = nullptr;
     QListView* m_view = nullptr;
     InventoryModel* m_model = nullptr;
-    InventoryProxyModel* m_proxy = nullptr;
     InventoryDelegate* m_delegate = nullptr;
 };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include "../BaseGameWidget.h"
 #include "../ManageBackupsWidget.h"
+#include "../../parse/Metrics.h"
 
 namespace fssm::ui::er {
 CharsListModel::CharsListModel(Controller* controller, const QString& saveId, QObject* parent)
@@ -27,7 +28,12 @@ void CharsListModel::refresh() {
 
     ERCharInfoResult charsInfo = m_controller->getERCharacters(m_saveId);
     if (!charsInfo.error.isEmpty()) {
-        m_chars = std::vector<fssm::parse::er::ERCharacterInfo>();
+        for (int i = 0; i < 10; ++i) {
+            m_changedChars[i] = m_chars[i] != nullptr;
+            m_chars[i].reset();
+        }
+        m_loadedChar.reset();
+        m_hasError = true;
         QStandardItem* item = root->child(0);
         item->setText(charsInfo.error);
         for (int i = 1; i < root->rowCount(); ++i) {
@@ -37,34 +43,89 @@ void CharsListModel::refresh() {
         emit refreshed();
         return;
     }
-    m_chars = charsInfo.characters;
-    for (int i = 0; i < root->rowCount(); ++i) {
+
+    // Compare with previous state by checksum of slot entry, only changed rows are updated
+    std::array<bool, 10> foundChars{};
+    const auto& userData10 = charsInfo.userData10;
+    for (int i = 0; i < 10; ++i) {
+        if (userData10->slotsSummary.occupied[i] == 0) continue;
+        const fssm::parse::er::SlotSummary& summary = userData10->slotsSummary.slots[i];
+        if (summary.index < 0 || summary.index >= 10) continue;
+        foundChars[summary.index] = true;
+        std::shared_ptr<const fssm::parse::er::SlotSummary>& current = m_chars[summary.index];
+        const bool changed = (
+            !current
+            || current->checksum != summary.checksum
+            || current->name != summary.name
+        );
+        m_changedChars[summary.index] = changed;
+        fssm::metrics::counter(changed ? "cache.characters.misses" : "cache.characters.hits").add();
+        // Aliasing pointer shares ownership of the whole snapshot, summary is not copied
+        if (changed) current = std::shared_ptr<const fssm::parse::er::SlotSummary>(userData10, &summary);
+    }
+    for (int i = 0; i < 10; ++i) {
+        if (foundChars[i]) continue;
+        m_changedChars[i] = m_chars[i] != nullptr;
+        m_chars[i].reset();
+    }
+    if (m_loadedChar && m_changedChars[m_loadedChar->index])
+        m_loadedChar.reset();
+
+    for (int i = 0; i < 10; ++i) {
+        if (!m_hasError && !m_changedChars[i]) continue;
         QStandardItem* item = root->child(i);
-        bool found = false;
-        for (auto& character: m_chars) {
-            if (i == character.index) {
-                item->setText(QString::fromStdU16String(character.name));
-                found = true;
-                break;
-            }
+        if (m_chars[i]) {
+            item->setText(QString::fromStdU16String(m_chars[i]->name));
+        } else {
+            item->setText("< Empty >");
         }
-        if (found) continue;
-        item->setText("< Empty >");
     }
+    m_hasError = false;
     emit refreshed();
 }
 
-const fssm::parse::er::ERCharacterInfo* CharsListModel::getCharByIdx(const int& index) const {
-    for (auto& character: m_chars) {
-        if (character.index == index) return &character;
+const fssm::parse::er::ERCharacterInfo* CharsListModel::getCharByIdx(const int& index) {
+    if (m_loadedChar && m_loadedChar->index == index) return m_loadedChar.get();
+    if (index < 0 || index >= 10 || !m_chars[index]) return nullptr;
+
+    ERCharacterResult charResult = m_controller->getERCharacter(m_saveId, index);
+    m_loadedChar = charResult.character;
+    if (!charResult.error.isEmpty()) {
+        // Show the error in the row of damaged slot, next refresh updates all rows
+        m_hasError = true;
+        invisibleRootItem()->child(index)->setText(charResult.error);
     }
-    return nullptr;
+    return m_loadedChar.get();
+}
+
+bool CharsListModel::isCharChanged(const int& index) const {
+    if (index < 0 || index >= 10) return false;
+    return m_changedChars[index];
 }
 };
 
 ERWidget::ERWidget(Controller* controller, const QString& saveId, QWidget* parent)
     : BaseGameWidget(controller, saveId, parent)
 {
+    setBackgroundRenderer([
+        bg = QImage(":/er_images/bg"),
+        overlay = QImage(":/er_images/bg_overlay")
+    ](const QSize& size, qreal devicePixelRatio) {
+        QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(devicePixelRatio);
+        image.fill(QColor(0, 0, 0));
+
+        QImage scaled = bg.scaled(size * 0.7 * devicePixelRatio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        scaled.setDevicePixelRatio(devicePixelRatio);
+        const QSizeF scaledSize = scaled.deviceIndependentSize();
+
+        QPainter painter(&image);
+        painter.drawImage(QPointF((size.width() - scaledSize.width()) / 2, (size.height() - scaledSize.height()) / 2), scaled);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        painter.drawImage(QRect(QPoint(0, 0), size), overlay);
+        return image;
+    });
+
     QWidget* viewWrap = new QWidget(this);
     viewWrap->setAttribute(Qt::WA_TranslucentBackground, true);
 
@@ -89,11 +150,16 @@ ERWidget::ERWidget(Controller* controller, const QString& saveId, QWidget* paren
     m_charTabs = new TabWidget(this);
 
     m_charInfoWidget = new fssm::ui::er::CharacterInfoWidget(m_charTabs);
+    m_inventoryWidget = new fssm::ui::er::InventoryWidget(m_charTabs);
 
     m_charTabs->addTab(
         "Character Info",
         m_charInfoWidget
     );
+    m_charTabs->addTab(
+        "Inventory",
+        m_inventoryWidget
+    );
 
     QHBoxLayout* mainLayout = new QHBoxLayout(this);
     mainLayout->setContentsMargins(20, 20, 20, 20);
@@ -114,8 +180,11 @@ void ERWidget::onRefresh() {
     for (auto& index: selModel->selectedIndexes()) {
         QVariant charId = index.data(fssm::ui::er::CharIdRole);
         if (!charId.isValid() || charId.isNull()) continue;
+        // Panes are rebuilt only if selected character did change
+        if (!m_model->isCharChanged(charId.toInt())) return;
         const fssm::parse::er::ERCharacterInfo* charInfo = m_model->getCharByIdx(charId.toInt());
         m_charInfoWidget->setCharacter(charInfo);
+        m_inventoryWidget->setCharacter(charInfo);
         return;
     }
     for (int row = 0; row < m_model->rowCount(); ++row) {
@@ -135,25 +204,10 @@ void ERWidget::onSelectionChange(const QItemSelection& selected, const QItemSele
         const fssm::parse::er::ERCharacterInfo* charInfo = m_model->getCharByIdx(charId.toInt());
 
         m_charInfoWidget->setCharacter(charInfo);
+        m_inventoryWidget->setCharacter(charInfo);
         return;
     }
     m_charInfoWidget->setCharacter(nullptr);
+    m_inventoryWidget->setCharacter(nullptr);
 
-}
-
-void ERWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter = QPainter(this);
-    painter.setClipRect(event->rect());
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(0, 0, 0));
-    painter.drawRect(rect());
-    QPixmap pix = QPixmap(":/er_images/bg");
-    QSize currentSize = size() * 0.7;
-    QPixmap scaled = pix.scaled(currentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    const int x = (width() - scaled.width()) / 2;
-    const int y = (height() - scaled.height()) / 2;
-    painter.drawPixmap(x, y, scaled);
-
-    QPixmap pixOverlay = QPixmap(":/er_images/bg_overlay");
-    painter.drawPixmap(0, 0, pixOverlay.scaled(size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <QStandardItemModel>
 
 #include "CharInfo.h"
+#include "Inventory.h"
 #include "../BaseGameWidget.h"
 
 namespace fssm::ui::er {
@@ -15,10 +16,17 @@ signals:
 public:
     explicit CharsListModel(Controller* controller, const QString& saveId, QObject* parent);
     void refresh();
-    const fssm::parse::er::ERCharacterInfo* getCharByIdx(const int& index) const;
+    // Character is fully parsed on first request, list uses only slot summaries
+    const fssm::parse::er::ERCharacterInfo* getCharByIdx(const int& index);
+    // Character in slot was added, removed or changed by last refresh
+    bool isCharChanged(const int& index) const;
 private:
-    std::vector<fssm::parse::er::ERCharacterInfo> m_chars;
-    std::array<QStandardItem*, 10> m_items;
+    // Slot summaries by slot index, point into shared USERDATA_10 snapshot
+    std::array<std::shared_ptr<const fssm::parse::er::SlotSummary>, 10> m_chars;
+    std::array<bool, 10> m_changedChars{};
+    bool m_hasError = false;
+    // Kept on refresh if its slot did not change
+    std::shared_ptr<const fssm::parse::er::ERCharacterInfo> m_loadedChar;
     QString m_saveId;
     Controller* m_controller;
 };
@@ -29,8 +37,6 @@ class ERWidget: public BaseGameWidget {
 public:
     explicit ERWidget(Controller* controller, const QString& saveId, QWidget* parent);
     void refresh() override;
-protected:
-    void paintEvent(QPaintEvent* event) override;
 private slots:
     void onSelectionChange(const QItemSelection& selected, const QItemSelection& deselected);
     void onRefresh();
@@ -39,4 +45,5 @@ private:
     TabWidget* m_charTabs = nullptr;
     fssm::ui::er::CharsListModel* m_model = nullptr;
     fssm::ui::er::CharacterInfoWidget* m_charInfoWidget = nullptr;
+    fssm::ui::er::InventoryWidget* m_inventoryWidget = nullptr;
 };
@@ -0,0 +1,176 @@
+#include "Inventory.h"
+
+#include <algorithm>
+
+#include <QVBoxLayout>
+
+#include "../../parse/Trace.h"
+
+namespace fssm::ui::er {
+static QString getItemTypeLabel(const parse::er::ItemType& itemType) {
+    switch (itemType) {
+        case parse::er::ItemType::Weapon: return "Weapons";
+        case parse::er::ItemType::Armor: return "Armor";
+        case parse::er::ItemType::Talisman: return "Talismans";
+        case parse::er::ItemType::Goods: return "Goods";
+        case parse::er::ItemType::AshOfWar: return "Ashes of War";
+        default: return "Unknown";
+    }
+}
+
+static QString getItemLabel(const InventoryRow& row) {
+    const parse::er::InventoryItem& invItem = *row.item;
+    QString label = "#";
+    label.append(QString::number(invItem.baseId()));
+    if (invItem.upgradeLevel > 0) {
+        label.append(" + ");
+        label.append(QString::number(invItem.upgradeLevel));
+    }
+    if (row.amount > 1 || row.storageAmount > 0) {
+        label.append(QString("    %1 / %2").arg(row.amount).arg(row.storageAmount));
+    }
+    return label;
+}
+
+InventoryModel::InventoryModel(QObject* parent): QAbstractListModel(parent) {}
+
+void InventoryModel::setCharacter(const fssm::parse::er::ERCharacterInfo* charInfo) {
+    FSSM_TRACE_SCOPE("ui.er.inventory_model");
+    beginResetModel();
+    // Vectors are cleared to keep their capacity for next character
+    m_rows.clear();
+    m_mergeIndex.clear();
+    if (charInfo != nullptr) {
+        m_rows.reserve(charInfo->inventoryItems.size() + charInfo->storageItems.size());
+        // Weapons, armor and ashes of war are unique GaItems, only stackable items are merged
+        for (const auto& invItem: charInfo->inventoryItems) {
+            if (invItem.type == parse::er::ItemType::Goods) addMergeIndex(invItem.itemId, m_rows.size());
+            m_rows.push_back({&invItem, invItem.amount, 0});
+        }
+
+        for (const auto& invItem: charInfo->storageItems) {
+            auto it = findMergeIndex(invItem.itemId);
+            if (it != m_mergeIndex.end() && it->first == invItem.itemId) {
+                m_rows[it->second].storageAmount = invItem.amount;
+                continue;
+            }
+            m_rows.push_back({&invItem, 0, invItem.amount});
+        }
+    }
+
+    for (auto& [itemType, rowIdxs]: m_typeRows) rowIdxs.clear();
+    for (size_t rowIdx = 0; rowIdx < m_rows.size(); ++rowIdx) {
+        m_typeRows[m_rows[rowIdx].item->type].push_back(rowIdx);
+    }
+    // Sort once by acquisition order, row index keeps the order stable
+    for (auto& [itemType, rowIdxs]: m_typeRows) {
+        std::sort(rowIdxs.begin(), rowIdxs.end(), [this](const size_t& left, const size_t& right) {
+            const uint32_t leftOrder = m_rows[left].item->order;
+            const uint32_t rightOrder = m_rows[right].item->order;
+            if (leftOrder != rightOrder) return leftOrder < rightOrder;
+            return left < right;
+        });
+    }
+    m_visibleRows = &m_typeRows[m_itemType];
+    endResetModel();
+}
+
+void InventoryModel::setItemType(parse::er::ItemType itemType) {
+    if (itemType == m_itemType && m_visibleRows != nullptr) return;
+    beginResetModel();
+    m_itemType = itemType;
+    m_visibleRows = &m_typeRows[m_itemType];
+    endResetModel();
+}
+
+int InventoryModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || m_visibleRows == nullptr) return 0;
+    return static_cast<int>(m_visibleRows->size());
+}
+
+Qt::ItemFlags InventoryModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled;
+}
+
+QVariant InventoryModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || m_visibleRows == nullptr || index.row() >= static_cast<int>(m_visibleRows->size()))
+        return QVariant();
+    const InventoryRow& row = m_rows[(*m_visibleRows)[index.row()]];
+    switch (role) {
+        case Qt::DisplayRole:
+            return getItemLabel(row);
+        case Qt::ToolTipRole:
+            return QString("Item ID: 0x%1").arg(row.item->itemId, 8, 16, QChar('0'));
+        case ItemTypeRole:
+            return QVariant::fromValue(row.item->type);
+        case ItemOrderRole:
+            return row.item->order;
+        case ItemAmountRole:
+            return row.amount;
+        case ItemStorageAmountRole:
+            return row.storageAmount;
+        default:
+            return QVariant();
+    }
+}
+
+std::vector<std::pair<uint32_t, size_t>>::iterator InventoryModel::findMergeIndex(const uint32_t& itemId) {
+    return std::lower_bound(
+        m_mergeIndex.begin(),
+        m_mergeIndex.end(),
+        itemId,
+        [](const std::pair<uint32_t, size_t>& item, const uint32_t& value) { return item.first < value; }
+    );
+}
+
+void InventoryModel::addMergeIndex(const uint32_t& itemId, const size_t& rowIdx) {
+    auto it = findMergeIndex(itemId);
+    if (it != m_mergeIndex.end() && it->first == itemId) {
+        it->second = rowIdx;
+        return;
+    }
+    m_mergeIndex.insert(it, {itemId, rowIdx});
+}
+
+InventoryWidget::InventoryWidget(QWidget* parent): QWidget(parent) {
+    setAttribute(Qt::WA_TranslucentBackground, true);
+
+    m_typeCombo = new QComboBox(this);
+    for (auto itemType: {
+        parse::er::ItemType::Weapon,
+        parse::er::ItemType::Armor,
+        parse::er::ItemType::Talisman,
+        parse::er::ItemType::Goods,
+        parse::er::ItemType::AshOfWar,
+    }) {
+        m_typeCombo->addItem(getItemTypeLabel(itemType), QVariant::fromValue(itemType));
+    }
+
+    m_view = new QListView(this);
+    m_view->setObjectName("er_list_view");
+    m_view->setAttribute(Qt::WA_TranslucentBackground, true);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+    m_model = new InventoryModel(this);
+    m_view->setModel(m_model);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_typeCombo, 0);
+    layout->addWidget(m_view, 1);
+
+    connect(m_typeCombo, SIGNAL(currentIndexChanged(int)), this, SLOT(onItemTypeChange(int)));
+
+    m_model->setItemType(parse::er::ItemType::Weapon);
+}
+
+void InventoryWidget::setCharacter(const fssm::parse::er::ERCharacterInfo* charInfo) {
+    m_model->setCharacter(charInfo);
+}
+
+void InventoryWidget::onItemTypeChange(int index) {
+    m_model->setItemType(m_typeCombo->itemData(index).value<parse::er::ItemType>());
+}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QComboBox>
+#include <QListView>
+#include <unordered_map>
+
+#include "../../parse/Parse.h"
+
+namespace fssm::ui::er {
+const int ItemTypeRole = Qt::UserRole + 1;
+const int ItemOrderRole = Qt::UserRole + 2;
+const int ItemAmountRole = Qt::UserRole + 3;
+const int ItemStorageAmountRole = Qt::UserRole + 4;
+
+// Row of inventory view, held and storage box goods may be merged to one row
+struct InventoryRow {
+    const parse::er::InventoryItem* item;
+    uint32_t amount;
+    uint32_t storageAmount;
+};
+
+// Model showing items of character directly, character info must outlive the model or be unset
+class InventoryModel: public QAbstractListModel {
+    Q_OBJECT
+public:
+    explicit InventoryModel(QObject* parent = nullptr);
+    void setCharacter(const parse::er::ERCharacterInfo* charInfo);
+    void setItemType(parse::er::ItemType itemType);
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+private:
+    std::vector<std::pair<uint32_t, size_t>>::iterator findMergeIndex(const uint32_t& itemId);
+    void addMergeIndex(const uint32_t& itemId, const size_t& rowIdx);
+
+    std::vector<InventoryRow> m_rows;
+    // Sorted pairs of item id and row index of mergeable items
+    std::vector<std::pair<uint32_t, size_t>> m_mergeIndex;
+    // Row indexes per item type sorted by item order, filled once per character
+    std::unordered_map<parse::er::ItemType, std::vector<size_t>> m_typeRows;
+    const std::vector<size_t>* m_visibleRows = nullptr;
+    parse::er::ItemType m_itemType = parse::er::ItemType::Weapon;
+};
+
+class InventoryWidget: public QWidget {
+    Q_OBJECT
+public:
+    explicit InventoryWidget(QWidget* parent);
+    void setCharacter(const fssm::parse::er::ERCharacterInfo* charInfo);
+private slots:
+    void onItemTypeChange(int index);
+private:
+    QComboBox* m_typeCombo = nullptr;
+    QListView* m_view = nullptr;
+    InventoryModel* m_model = nullptr;
+};
+}
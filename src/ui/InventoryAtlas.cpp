@@ -0,0 +1,47 @@
+#include "InventoryAtlas.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "InvAtlasIndex.h"
+
+namespace {
+    const fssm::ui::AtlasSprite* findSprite(std::string_view key, int size) {
+        auto it = std::lower_bound(
+            fssm::ui::INV_ATLAS_SPRITES.begin(),
+            fssm::ui::INV_ATLAS_SPRITES.end(),
+            std::make_tuple(key, size),
+            [](const fssm::ui::AtlasSprite& sprite, const std::tuple<std::string_view, int>& value) {
+                return std::make_tuple(sprite.key, sprite.size) < value;
+            }
+        );
+        if (it == fssm::ui::INV_ATLAS_SPRITES.end() || it->key != key || it->size != size) return nullptr;
+        return &(*it);
+    }
+}
+
+InventoryAtlas* InventoryAtlas::instance() {
+    static InventoryAtlas atlas;
+    return &atlas;
+}
+
+QImage InventoryAtlas::getPage(const QString& page) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pages.find(page);
+    if (it != m_pages.end()) return it->second;
+    QImage image(":/inv_atlas/" + page);
+    m_pages[page] = image;
+    return image;
+}
+
+QImage InventoryAtlas::image(const QString& path, int size) {
+    // Resource paths start with ':/' which is not part of the key
+    if (!path.startsWith(":/")) return QImage{};
+    const QByteArray key = path.mid(2).toUtf8();
+    const fssm::ui::AtlasSprite* sprite = findSprite(std::string_view(key.constData(), key.size()), size);
+    if (sprite == nullptr) return QImage{};
+
+    QImage page = getPage(QString::fromUtf8(sprite->page.data(), static_cast<qsizetype>(sprite->page.size())));
+    if (page.isNull()) return QImage{};
+    return page.copy(sprite->x, sprite->y, sprite->width, sprite->height);
+}
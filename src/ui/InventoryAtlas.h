@@ -0,0 +1,25 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <QImage>
+#include <QString>
+
+// Atlases of pre-downscaled inventory images generated by 'gen_resources.py --atlas'
+// - contains images only in sizes used by inventory delegates, other sizes must be scaled at runtime
+// - each atlas page is decoded once and kept, returned images are copied from the page
+// - can be used from worker threads
+class InventoryAtlas {
+public:
+    static InventoryAtlas* instance();
+
+    // Image fitting square of 'size' physical pixels, null image if atlas does not contain it
+    QImage image(const QString& path, int size);
+
+private:
+    InventoryAtlas() = default;
+    QImage getPage(const QString& page);
+
+    std::mutex m_mutex;
+    std::unordered_map<QString, QImage> m_pages;
+};
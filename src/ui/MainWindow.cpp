@@ -16,13 +16,6 @@ MainWindow::MainWindow(Controller* controller, QWidget* parent)
 
     m_stack = new QStackedWidget(this);
 
-    m_blurEffect = new QGraphicsBlurEffect(m_stack);
-    m_blurEffect->setEnabled(false);
-    m_blurEffect->setBlurHints(QGraphicsBlurEffect::QualityHint);
-    m_blurEffect->setBlurRadius(0.0);
-
-    m_stack->setGraphicsEffect(m_blurEffect);
-
     m_settingsWidget = new SettingsWidget(controller, m_stack);
 
     m_manageBackupsOverlay = new ManageBackupsOverlayWidget(controller, this);
@@ -40,6 +33,10 @@ MainWindow::MainWindow(Controller* controller, QWidget* parent)
     m_manageOpacityAnim->setStartValue(0.0);
     m_manageOpacityAnim->setEndValue(1.0);
 
+    m_backdropTimer = new QTimer(this);
+    m_backdropTimer->setSingleShot(true);
+    m_backdropTimer->setInterval(50);
+
     m_stack->addWidget(m_settingsWidget);
 
     m_saveId = "";
@@ -57,6 +54,7 @@ MainWindow::MainWindow(Controller* controller, QWidget* parent)
     connect(m_manageBackupsOverlay, SIGNAL(hideRequested()), this, SLOT(onHideBackupsRequest()));
     connect(m_manageOpacityAnim, SIGNAL(valueChanged(const QVariant&)), this, SLOT(onOpacityAnimChange(const QVariant&)));
     connect(m_manageOpacityAnim, SIGNAL(finished()), this, SLOT(onOpacityAnimFinish()));
+    connect(m_backdropTimer, SIGNAL(timeout()), this, SLOT(updateBackupsBackdrop()));
 }
 
 void MainWindow::showEvent(QShowEvent *event) {
@@ -73,57 +71,50 @@ void MainWindow::refresh() {
     std::unordered_set<QString> availableIds;
     QString firstId;
     for (const auto&[game, saveId, _savePath]: m_controller->getSaveFileItems()) {
-        BaseGameWidget* gameWidget = nullptr;
         if (firstId.isEmpty()) firstId = saveId;
         availableIds.insert(saveId);
-        if (m_widgetsMapping.find(saveId) != m_widgetsMapping.end()) {
-            gameWidget = m_widgetsMapping.find(saveId)->second;
-            gameWidget->refresh();
+        if (m_saveGames.find(saveId) != m_saveGames.end()) {
+            auto wIt = m_widgetsMapping.find(saveId);
+            if (wIt == m_widgetsMapping.end()) continue;
+            // Only visible game widget is refreshed, others are refreshed when shown
+            if (saveId == m_saveId) {
+                wIt->second->refresh();
+            } else {
+                m_dirtySaveIds.insert(saveId);
+            }
             continue;
         }
         switch (game) {
             case fssm::Game::DSR:
-                gameWidget = new DSRWidget(m_controller, saveId, m_stack);
-                break;
             case fssm::Game::DS2_SOTFS:
-                gameWidget = new DS2Widget(m_controller, saveId, m_stack);
-                break;
-
             case fssm::Game::DS3:
-                gameWidget = new DS3Widget(m_controller, saveId, m_stack);
-                break;
-
             case fssm::Game::Sekiro:
-                gameWidget = new SekiroWidget(m_controller, saveId, m_stack);
-                break;
-
             case fssm::Game::ER:
-                gameWidget = new ERWidget(m_controller, saveId, m_stack);
+                m_saveGames[saveId] = game;
+                m_sideBar->addTab(game, saveId);
                 break;
 
             default:
                 break;
         }
-        if (gameWidget != nullptr) {
-            m_stack->addWidget(gameWidget);
-            m_widgetsMapping[saveId] = gameWidget;
-            m_sideBar->addTab(game, saveId);
-            gameWidget->refresh();
-            connect(gameWidget, SIGNAL(showBackupsRequested()), this, SLOT(onShowBackupsRequest()));
-        }
     }
-    std::unordered_map<QString, BaseGameWidget*>::iterator it = m_widgetsMapping.begin();
-    while (it != m_widgetsMapping.end()) {
+    std::unordered_map<QString, fssm::Game>::iterator it = m_saveGames.begin();
+    while (it != m_saveGames.end()) {
         if (availableIds.find(it->first) != availableIds.end()) {
             it = std::next(it);
             continue;
         }
 
-        it->second->setVisible(false);
-        it->second->deleteLater();
-        m_stack->removeWidget(it->second);
+        auto wIt = m_widgetsMapping.find(it->first);
+        if (wIt != m_widgetsMapping.end()) {
+            wIt->second->setVisible(false);
+            wIt->second->deleteLater();
+            m_stack->removeWidget(wIt->second);
+            m_widgetsMapping.erase(wIt);
+        }
+        m_dirtySaveIds.erase(it->first);
         m_sideBar->removeTab(it->first);
-        it = m_widgetsMapping.erase(it);
+        it = m_saveGames.erase(it);
     }
 
     QString saveId = m_controller->getLastSelectedSaveId();
@@ -134,12 +125,64 @@ void MainWindow::refresh() {
         m_sideBar->setCurrentTab(saveId);
 }
 
+BaseGameWidget* MainWindow::getOrCreateGameWidget(const QString& saveId) {
+    auto wIt = m_widgetsMapping.find(saveId);
+    if (wIt != m_widgetsMapping.end()) {
+        if (m_dirtySaveIds.erase(saveId) > 0) wIt->second->refresh();
+        return wIt->second;
+    }
+
+    auto gIt = m_saveGames.find(saveId);
+    if (gIt == m_saveGames.end()) return nullptr;
+
+    BaseGameWidget* gameWidget = nullptr;
+    switch (gIt->second) {
+        case fssm::Game::DSR:
+            gameWidget = new DSRWidget(m_controller, saveId, m_stack);
+            break;
+        case fssm::Game::DS2_SOTFS:
+            gameWidget = new DS2Widget(m_controller, saveId, m_stack);
+            break;
+
+        case fssm::Game::DS3:
+            gameWidget = new DS3Widget(m_controller, saveId, m_stack);
+            break;
+
+        case fssm::Game::Sekiro:
+            gameWidget = new SekiroWidget(m_controller, saveId, m_stack);
+            break;
+
+        case fssm::Game::ER:
+            gameWidget = new ERWidget(m_controller, saveId, m_stack);
+            break;
+
+        default:
+            return nullptr;
+    }
+    m_stack->addWidget(gameWidget);
+    m_widgetsMapping[saveId] = gameWidget;
+    gameWidget->refresh();
+    connect(gameWidget, SIGNAL(showBackupsRequested()), this, SLOT(onShowBackupsRequest()));
+    return gameWidget;
+}
+
 void MainWindow::updateOverlayGeo() {
     if (m_manageBackupsOverlay->isVisible()) {
+        const bool sizeChanged = m_manageBackupsOverlay->size() != m_stack->size();
         m_manageBackupsOverlay->setGeometry(m_stack->geometry());
+        if (sizeChanged) scheduleBackdropUpdate();
     }
 }
 
+void MainWindow::scheduleBackdropUpdate() {
+    if (m_manageBackupsOverlay->isVisible()) m_backdropTimer->start();
+}
+
+void MainWindow::updateBackupsBackdrop() {
+    // Stack is rendered once and blurred, overlay paints the result until content changes
+    m_manageBackupsOverlay->setBackdrop(m_stack->grab().toImage());
+}
+
 void MainWindow::onTabChange(const QString& saveId) {
     if (m_saveId == saveId) return;
     // Empty save id is settings widget
@@ -151,23 +194,34 @@ void MainWindow::onTabChange(const QString& saveId) {
         return;
     }
 
+    // Widget is created and parsed on first activation
+    BaseGameWidget* gameWidget = getOrCreateGameWidget(saveId);
     // Save id not found
-    if (m_widgetsMapping.find(saveId) == m_widgetsMapping.end()) return;
+    if (gameWidget == nullptr) return;
     // Discard changes if the current tab is settings
     if (m_saveId == "") m_settingsWidget->discardChanges();
 
     // Change visible widget
-    m_stack->setCurrentWidget(m_widgetsMapping.find(saveId)->second);
+    m_stack->setCurrentWidget(gameWidget);
     m_saveId = saveId;
     m_controller->setCurrentTabId(saveId);
 
-    if (m_saveId != "" && m_manageBackupsOverlay->isVisible())
+    if (m_saveId != "" && m_manageBackupsOverlay->isVisible()) {
         m_manageBackupsOverlay->refresh();
+        scheduleBackdropUpdate();
+    }
 }
 
 void MainWindow::onSaveIdChange(const QString& saveId) {
     auto wIt = m_widgetsMapping.find(saveId);
-    if (wIt != m_widgetsMapping.end()) wIt->second->refresh();
+    // Not yet created widgets will parse the save on first activation
+    if (wIt == m_widgetsMapping.end()) return;
+    if (saveId == m_saveId) {
+        wIt->second->refresh();
+        scheduleBackdropUpdate();
+    } else {
+        m_dirtySaveIds.insert(saveId);
+    }
 }
 
 void MainWindow::onPathsConfigChange() {
@@ -175,7 +229,10 @@ void MainWindow::onPathsConfigChange() {
 }
 
 void MainWindow::onShowBackupsRequest() {
-    m_blurEffect->setEnabled(true);
+    if (!m_manageBackupsOverlay->isVisible()) {
+        m_backdropTimer->stop();
+        updateBackupsBackdrop();
+    }
     m_manageOpacityEffect->setEnabled(true);
     m_manageBackupsOverlay->setVisible(true);
     if (m_manageOpacityAnim->direction() == QVariantAnimation::Backward)
@@ -199,9 +256,7 @@ void MainWindow::onHideBackupsRequest() {
 }
 
 void MainWindow::onOpacityAnimChange(const QVariant& value) {
-    double dValue = value.toDouble();
-    m_manageOpacityEffect->setOpacity(dValue);
-    m_blurEffect->setBlurRadius(5.0 * dValue);
+    m_manageOpacityEffect->setOpacity(value.toDouble());
 }
 
 void MainWindow::onOpacityAnimFinish() {
@@ -209,12 +264,10 @@ void MainWindow::onOpacityAnimFinish() {
     onOpacityAnimChange(value);
 
     if (m_manageOpacityEffect->opacity() == 0.0) {
-        // Overlay can be hidden and blur effect fully disabled
+        // Overlay can be hidden and backdrop released
         m_manageBackupsOverlay->setVisible(false);
-        m_blurEffect->setEnabled(false);
-    } else {
-        // Set last value of blue effect
-        m_blurEffect->setBlurRadius(5.0);
+        m_manageBackupsOverlay->setBackdrop(QImage{});
+        m_backdropTimer->stop();
     }
     // Always disable opacity effect on finished animation
     m_manageOpacityEffect->setEnabled(false);
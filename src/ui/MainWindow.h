@@ -1,7 +1,8 @@
 #pragma once
 
 #include <QStackedWidget>
-#include <QGraphicsBlurEffect>
+#include <QGraphicsOpacityEffect>
+#include <QTimer>
 
 #include "Controller.h"
 #include "ManageBackupsWidget.h"
@@ -26,6 +27,7 @@ private slots:
     void onHideBackupsRequest();
     void onOpacityAnimChange(const QVariant& value);
     void onOpacityAnimFinish();
+    void updateBackupsBackdrop();
 private:
     QString m_saveId;
     Controller* m_controller = nullptr;
@@ -34,8 +36,15 @@ private:
     SettingsWidget* m_settingsWidget = nullptr;
     std::unordered_map<QString, BaseGameWidget*> m_widgetsMapping;
     ManageBackupsOverlayWidget* m_manageBackupsOverlay = nullptr;
-    QGraphicsBlurEffect* m_blurEffect = nullptr;
+    // Coalesces backdrop updates when widgets under visible backups overlay change
+    QTimer* m_backdropTimer = nullptr;
     QGraphicsOpacityEffect* m_manageOpacityEffect = nullptr;
     QVariantAnimation* m_manageOpacityAnim = nullptr;
+    // Game of each available save id, game widgets are created on first activation
+    std::unordered_map<QString, fssm::Game> m_saveGames;
+    // Save ids of created widgets that should refresh when shown
+    std::unordered_set<QString> m_dirtySaveIds;
     void updateOverlayGeo();
+    void scheduleBackdropUpdate();
+    BaseGameWidget* getOrCreateGameWidget(const QString& saveId);
 };
@@ -1,8 +1,9 @@
 #include "ManageBackupsWidget.h"
 
+#include <vector>
+
 #include <QSplitter>
 #include <QTreeView>
-#include <QGraphicsBlurEffect>
 #include <QStackedLayout>
 #include <QPainter>
 #include <QMenu>
@@ -15,6 +16,66 @@ namespace {
 const int BackupIdRole = Qt::UserRole + 1;
 const int BackupDateRole = Qt::UserRole + 2;
 const int BackupSortRole = Qt::UserRole + 3;
+
+// Backdrop is blurred in lower resolution, upscaling smooths it even more
+const int BackdropDownscale = 4;
+const int BackdropBlurRadius = 2;
+
+// Single pass of box blur in one direction on premultiplied ARGB image
+void boxBlurPass(QImage& image, int radius, bool horizontal) {
+    const int width = image.width();
+    const int height = image.height();
+    const int lines = horizontal ? height : width;
+    const int length = horizontal ? width : height;
+    const int window = radius * 2 + 1;
+    std::vector<QRgb> buffer(length);
+    for (int line = 0; line < lines; ++line) {
+        for (int idx = 0; idx < length; ++idx) {
+            buffer[idx] = horizontal
+                ? reinterpret_cast<const QRgb*>(image.constScanLine(line))[idx]
+                : reinterpret_cast<const QRgb*>(image.constScanLine(idx))[line];
+        }
+        int sums[4] = {0, 0, 0, 0};
+        // Edge pixels are repeated outside of image
+        for (int offset = -radius; offset <= radius; ++offset) {
+            const QRgb pixel = buffer[qBound(0, offset, length - 1)];
+            sums[0] += qAlpha(pixel);
+            sums[1] += qRed(pixel);
+            sums[2] += qGreen(pixel);
+            sums[3] += qBlue(pixel);
+        }
+        for (int idx = 0; idx < length; ++idx) {
+            QRgb* dst = horizontal
+                ? reinterpret_cast<QRgb*>(image.scanLine(line)) + idx
+                : reinterpret_cast<QRgb*>(image.scanLine(idx)) + line;
+            *dst = qRgba(sums[1] / window, sums[2] / window, sums[3] / window, sums[0] / window);
+            const QRgb removed = buffer[qMax(0, idx - radius)];
+            const QRgb added = buffer[qMin(length - 1, idx + radius + 1)];
+            sums[0] += qAlpha(added) - qAlpha(removed);
+            sums[1] += qRed(added) - qRed(removed);
+            sums[2] += qGreen(added) - qGreen(removed);
+            sums[3] += qBlue(added) - qBlue(removed);
+        }
+    }
+}
+
+// Three box blur passes are close to gaussian blur
+QImage blurImage(const QImage& source, int downscale, int radius) {
+    if (source.isNull()) return QImage{};
+    QImage image = source
+        .scaled(
+            qMax(1, source.width() / downscale),
+            qMax(1, source.height() / downscale),
+            Qt::IgnoreAspectRatio,
+            Qt::SmoothTransformation
+        )
+        .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int pass = 0; pass < 3; ++pass) {
+        boxBlurPass(image, radius, true);
+        boxBlurPass(image, radius, false);
+    }
+    return image;
+}
 }
 
 
@@ -262,6 +323,18 @@ void ManageBackupsOverlayWidget::keyPressEvent(QKeyEvent *event) {
     }
 }
 
+void ManageBackupsOverlayWidget::setBackdrop(const QImage& snapshot) {
+    m_backdropPix = QPixmap::fromImage(blurImage(snapshot, BackdropDownscale, BackdropBlurRadius));
+    update();
+}
+
+void ManageBackupsOverlayWidget::paintEvent(QPaintEvent* event) {
+    if (m_backdropPix.isNull()) return;
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawPixmap(rect(), m_backdropPix);
+}
+
 void ManageBackupsOverlayWidget::refresh() {
     auto watcher = new QFutureWatcher<std::vector<BackupMetadata>>(this);
 
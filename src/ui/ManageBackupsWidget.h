@@ -49,8 +49,11 @@ signals:
 public:
     explicit ManageBackupsOverlayWidget(Controller* controller, QWidget* parent);
     void refresh();
+    // Snapshot of widgets under the overlay, it is blurred once and painted as background
+    void setBackdrop(const QImage& snapshot);
 protected:
     void keyPressEvent(QKeyEvent *event) override;
+    void paintEvent(QPaintEvent* event) override;
 private slots:
     void onDeleteBackups();
     void onCreateBackup();
@@ -64,6 +67,7 @@ private:
     QSortFilterProxyModel* m_proxyModel = nullptr;
     QTreeView* m_backupsView = nullptr;
     QPushButton* m_deleteBackupsBtn = nullptr;
+    QPixmap m_backdropPix;
     void p_loadBackup(const QString& backupId);
 };
 
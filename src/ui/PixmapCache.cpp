@@ -0,0 +1,193 @@
+#include "PixmapCache.h"
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QThread>
+
+#ifdef FSSM_USE_ASSET_PACK
+#include "AssetPack.h"
+#endif
+#ifdef FSSM_USE_INV_ATLAS
+#include "InventoryAtlas.h"
+#endif
+
+// 64 MiB is enough for all inventory images of one game in multiple sizes
+const qint64 DefaultBudget = 64 * 1024 * 1024;
+
+ScaledPixmapCache* ScaledPixmapCache::instance() {
+    // Owned by application, pixmaps can't outlive QGuiApplication
+    static ScaledPixmapCache* cache = new ScaledPixmapCache(DefaultBudget, QCoreApplication::instance());
+    return cache;
+}
+
+// Inventory images may be stored in memory mapped asset pack instead of qrc
+static QImage loadImage(const QString& path) {
+#ifdef FSSM_USE_ASSET_PACK
+    AssetPack* pack = AssetPack::instance();
+    if (pack->contains(path)) return pack->image(path);
+#endif
+    return QImage(path);
+}
+
+static QImage loadScaledImage(
+    const QString& path,
+    const QSize& size,
+    qreal devicePixelRatio,
+    Qt::AspectRatioMode aspectMode
+) {
+    const QSize targetSize = size * devicePixelRatio;
+#ifdef FSSM_USE_INV_ATLAS
+    // Pre-downscaled image from atlas does not need decoding of source image nor scaling
+    if (aspectMode == Qt::KeepAspectRatio && targetSize.width() == targetSize.height()) {
+        QImage sprite = InventoryAtlas::instance()->image(path, targetSize.width());
+        if (!sprite.isNull()) return sprite;
+    }
+#endif
+    QImage image = loadImage(path);
+    if (image.isNull()) return image;
+    return image.scaled(targetSize, aspectMode, Qt::SmoothTransformation);
+}
+
+static QString createKey(
+    const QString& path,
+    const QSize& size,
+    qreal devicePixelRatio,
+    Qt::AspectRatioMode aspectMode
+) {
+    return QString("%1|%2x%3|%4|%5")
+        .arg(path)
+        .arg(size.width())
+        .arg(size.height())
+        .arg(devicePixelRatio)
+        .arg(static_cast<int>(aspectMode));
+}
+
+ScaledPixmapCache::ScaledPixmapCache(qint64 budget, QObject* parent): QObject(parent) {
+    setBudget(budget);
+    // Keep one core free for GUI thread
+    m_decodePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this, SLOT(onAboutToQuit()));
+}
+
+ScaledPixmapCache::~ScaledPixmapCache() {
+    onAboutToQuit();
+}
+
+void ScaledPixmapCache::onAboutToQuit() {
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_jobs.clear();
+    }
+    m_decodePool.waitForDone();
+    m_cache.clear();
+    m_pendingKeys.clear();
+}
+
+QPixmap ScaledPixmapCache::get(
+    const QString& path,
+    const QSize& size,
+    qreal devicePixelRatio,
+    Qt::AspectRatioMode aspectMode
+) {
+    const QString key = createKey(path, size, devicePixelRatio, aspectMode);
+    if (QPixmap* cached = m_cache.object(key)) {
+        m_hits.add();
+        return *cached;
+    }
+    m_misses.add();
+
+    if (size.isEmpty()) return QPixmap{};
+    QImage image = loadScaledImage(path, size, devicePixelRatio, aspectMode);
+    if (image.isNull()) return QPixmap{};
+
+    QPixmap* scaled = new QPixmap(QPixmap::fromImage(image));
+    scaled->setDevicePixelRatio(devicePixelRatio);
+    const qint64 cost = qMax<qint64>(1, (qint64(scaled->width()) * scaled->height() * scaled->depth() / 8) / 1024);
+    QPixmap result = *scaled;
+    m_cache.insert(key, scaled, cost);
+    return result;
+}
+
+QPixmap ScaledPixmapCache::getAsync(
+    const QString& path,
+    const QSize& size,
+    qreal devicePixelRatio,
+    Qt::AspectRatioMode aspectMode,
+    bool* pending
+) {
+    if (pending != nullptr) *pending = false;
+    if (size.isEmpty()) return QPixmap{};
+
+    const QString key = createKey(path, size, devicePixelRatio, aspectMode);
+    if (QPixmap* cached = m_cache.object(key)) {
+        m_hits.add();
+        return *cached;
+    }
+    if (m_failedKeys.find(key) != m_failedKeys.end()) return QPixmap{};
+    if (pending != nullptr) *pending = true;
+    if (!m_pendingKeys.insert(key).second) {
+        // Requested again (row scrolled back to view), queued job is moved to the top
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        auto it = std::find_if(m_jobs.begin(), m_jobs.end(), [&key](const DecodeJob& job) { return job.key == key; });
+        if (it != m_jobs.end()) std::rotate(it, it + 1, m_jobs.end());
+        return QPixmap{};
+    }
+
+    m_misses.add();
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_jobs.push_back({key, path, size, devicePixelRatio, aspectMode});
+    }
+    m_decodePool.start([this]() { decodeNext(); });
+    return QPixmap{};
+}
+
+void ScaledPixmapCache::decodeNext() {
+    DecodeJob job;
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        if (m_jobs.empty()) return;
+        job = std::move(m_jobs.back());
+        m_jobs.pop_back();
+    }
+    // QImage can be used outside of GUI thread, conversion to QPixmap happens on GUI thread
+    QImage image = loadScaledImage(job.path, job.size, job.devicePixelRatio, job.aspectMode);
+    QMetaObject::invokeMethod(
+        this,
+        [this, key = job.key, image = std::move(image), dpr = job.devicePixelRatio]() {
+            onImageDecoded(key, image, dpr);
+        },
+        Qt::QueuedConnection
+    );
+}
+
+void ScaledPixmapCache::onImageDecoded(const QString& key, const QImage& image, qreal devicePixelRatio) {
+    m_pendingKeys.erase(key);
+    if (image.isNull()) {
+        m_failedKeys.insert(key);
+    } else {
+        QPixmap* pixmap = new QPixmap(QPixmap::fromImage(image));
+        pixmap->setDevicePixelRatio(devicePixelRatio);
+        const qint64 cost = qMax<qint64>(1, (qint64(pixmap->width()) * pixmap->height() * pixmap->depth() / 8) / 1024);
+        m_cache.insert(key, pixmap, cost);
+    }
+    emit pixmapLoaded();
+}
+
+void ScaledPixmapCache::clear() {
+    m_cache.clear();
+    m_failedKeys.clear();
+}
+
+void ScaledPixmapCache::setBudget(qint64 budget) {
+    m_cache.setMaxCost(qMax<qint64>(1, budget / 1024));
+}
+
+qint64 ScaledPixmapCache::budget() const {
+    return m_cache.maxCost() * 1024;
+}
+
+qint64 ScaledPixmapCache::usedBytes() const {
+    return m_cache.totalCost() * 1024;
+}
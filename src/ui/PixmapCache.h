@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QThreadPool>
+
+#include "../parse/Metrics.h"
+
+// App wide cache of scaled pixmaps keyed by resource path, target size and device pixel ratio
+// - cost of cached pixmaps is limited by memory budget, least recently used pixmaps are dropped first
+// - returned pixmaps have device pixel ratio set so they can be drawn without additional scaling
+// - 'getAsync' decodes images on worker threads, newest requests are decoded first so rows
+//      in current viewport are loaded before rows which were scrolled away
+class ScaledPixmapCache: public QObject {
+    Q_OBJECT
+signals:
+    // Emitted on GUI thread when asynchronously requested pixmap is available
+    void pixmapLoaded();
+public:
+    static ScaledPixmapCache* instance();
+
+    QPixmap get(
+        const QString& path,
+        const QSize& size,
+        qreal devicePixelRatio,
+        Qt::AspectRatioMode aspectMode = Qt::KeepAspectRatio
+    );
+    // Return cached pixmap or null pixmap and schedule decoding, 'pending' is set to false
+    //      if the image could not be loaded
+    QPixmap getAsync(
+        const QString& path,
+        const QSize& size,
+        qreal devicePixelRatio,
+        Qt::AspectRatioMode aspectMode = Qt::KeepAspectRatio,
+        bool* pending = nullptr
+    );
+    void clear();
+
+    // Memory budget in bytes
+    void setBudget(qint64 budget);
+    qint64 budget() const;
+    qint64 usedBytes() const;
+    quint64 hits() const { return m_hits.value(); }
+    quint64 misses() const { return m_misses.value(); }
+
+private slots:
+    // Drop queued jobs, wait for running decodes and release pixmaps while GUI is still alive
+    void onAboutToQuit();
+private:
+    struct DecodeJob {
+        QString key;
+        QString path;
+        QSize size;
+        qreal devicePixelRatio = 1.0;
+        Qt::AspectRatioMode aspectMode = Qt::KeepAspectRatio;
+    };
+
+    ScaledPixmapCache(qint64 budget, QObject* parent);
+    ~ScaledPixmapCache() override;
+    void decodeNext();
+    void onImageDecoded(const QString& key, const QImage& image, qreal devicePixelRatio);
+
+    // Cost is stored in KiB to fit large budgets
+    QCache<QString, QPixmap> m_cache;
+    // Shared with diagnostics in settings
+    fssm::metrics::Counter& m_hits = fssm::metrics::counter("cache.pixmap.hits");
+    fssm::metrics::Counter& m_misses = fssm::metrics::counter("cache.pixmap.misses");
+
+    QThreadPool m_decodePool;
+    // Requested jobs, worker always takes the last one
+    std::mutex m_jobsMutex;
+    std::vector<DecodeJob> m_jobs;
+    // Keys which are queued or being decoded, used only on GUI thread
+    std::unordered_set<QString> m_pendingKeys;
+    // Keys of images which failed to load
+    std::unordered_set<QString> m_failedKeys;
+};
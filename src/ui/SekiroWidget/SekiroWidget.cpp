@@ -9,7 +9,9 @@
 SekiroWidget::SekiroWidget(Controller* controller, const QString& saveId, QWidget* parent)
     : BaseGameWidget(controller, saveId, parent)
 {
-    m_bgPix = QPixmap(":/sekiro_images/bg");
+    setBackgroundRenderer([bg = QImage(":/sekiro_images/bg")](const QSize& size, qreal devicePixelRatio) {
+        return renderCoverBackground(bg, size, devicePixelRatio, QColor(6, 5, 7), Qt::AlignCenter);
+    });
     ManageBackupsButtonsWidget* manageBackupsBtnsWidget = new ManageBackupsButtonsWidget(controller, this);
 
     QLabel* infoLabel = new QLabel("Sekiro viewer is not implemented yet", this);
@@ -28,18 +30,4 @@ SekiroWidget::SekiroWidget(Controller* controller, const QString& saveId, QWidge
 
 void SekiroWidget::refresh() {
     // TODO implement
-}
-
-void SekiroWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter = QPainter(this);
-    painter.setClipRect(event->rect());
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(6, 5, 7));
-    const QRect targetRect = rect();
-    painter.drawRect(targetRect);
-    QPixmap scaled = m_bgPix.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    // center vertically
-    const int x = (width() - scaled.width()) / 2;
-    const int y = (height() - scaled.height()) / 2;
-    painter.drawPixmap(x, y, scaled);
 }
\ No newline at end of file
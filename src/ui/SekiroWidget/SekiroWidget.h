@@ -6,8 +6,4 @@ class SekiroWidget: public BaseGameWidget {
 public:
     explicit SekiroWidget(Controller* controller, const QString& saveId, QWidget* parent);
     void refresh() override;
-protected:
-    void paintEvent(QPaintEvent* event) override;
-private:
-    QPixmap m_bgPix;
 };
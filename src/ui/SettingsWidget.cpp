@@ -5,6 +5,8 @@
 #include <QFileDialog>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QStandardPaths>
+#include <QtConcurrent>
 
 
 SavePathInput::SavePathInput(const QString& gameTitle, QWidget* parent): QFrame(parent) {
@@ -338,6 +340,155 @@ void AutoBackupWidget::applyChanges(const ConfigSettingsData& configData, Config
     }
 };
 
+DiagnosticsWidget::DiagnosticsWidget(Controller* controller, const ConfigSettingsData& configData, QWidget* parent): QWidget(parent), m_controller(controller) {
+    QLabel* tracingLabel = new QLabel("Tracing", this);
+    tracingLabel->setToolTip("Record duration of file reads, parsing, painting and backups.\nTrace can be opened in https://ui.perfetto.dev");
+    m_tracingInput = new NiceCheckbox(this);
+
+    QPushButton* writeTraceBtn = new QPushButton("Write trace..", this);
+    m_traceStatusLabel = new QLabel(this);
+
+    m_statsLabel = new QLabel(this);
+    m_statsLabel->setTextFormat(Qt::RichText);
+    m_statsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    m_statsTimer = new QTimer(this);
+    m_statsTimer->setInterval(1000);
+
+    updateConfigInfo(configData);
+
+    QGridLayout* layout = new QGridLayout(this);
+    layout->addWidget(tracingLabel, 0, 0);
+    layout->addWidget(m_tracingInput, 0, 1);
+    layout->addWidget(writeTraceBtn, 1, 0);
+    layout->addWidget(m_traceStatusLabel, 1, 1, 1, 2);
+    layout->addWidget(m_statsLabel, 2, 0, 1, 3);
+
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setVerticalSpacing(5);
+    layout->setColumnStretch(0, 0);
+    layout->setColumnStretch(1, 0);
+    layout->setColumnStretch(2, 1);
+
+    connect(writeTraceBtn, SIGNAL(clicked()), this, SLOT(onWriteTrace()));
+    connect(m_statsTimer, SIGNAL(timeout()), this, SLOT(refreshStats()));
+};
+
+DiagnosticsWidget::~DiagnosticsWidget() {
+    m_backupSizesFuture.waitForFinished();
+}
+
+void DiagnosticsWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (!m_backupSizesFuture.isRunning()) {
+        Controller* controller = m_controller;
+        m_backupSizesFuture = QtConcurrent::run([controller]() { controller->updateBackupSizes(); });
+    }
+    refreshStats();
+    m_statsTimer->start();
+}
+
+void DiagnosticsWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    m_statsTimer->stop();
+}
+
+static QString formatLatency(const fssm::metrics::Snapshot& snapshot, const std::string& name) {
+    auto it = snapshot.latencies.find(name);
+    if (it == snapshot.latencies.end() || it->second.count == 0) return "-";
+    return QString("%1 / %2 ms (%3)")
+        .arg(it->second.lastMs, 0, 'f', 1)
+        .arg(it->second.p95Ms, 0, 'f', 1)
+        .arg(it->second.count);
+}
+
+static QString formatHitRate(const fssm::metrics::Snapshot& snapshot, const std::string& prefix) {
+    auto hitsIt = snapshot.counters.find(prefix + ".hits");
+    auto missesIt = snapshot.counters.find(prefix + ".misses");
+    uint64_t hits = hitsIt != snapshot.counters.end() ? hitsIt->second : 0;
+    uint64_t misses = missesIt != snapshot.counters.end() ? missesIt->second : 0;
+    if (hits + misses == 0) return "-";
+    double rate = 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses);
+    return QString("%1 % (%2 / %3)").arg(rate, 0, 'f', 1).arg(hits).arg(hits + misses);
+}
+
+void DiagnosticsWidget::refreshStats() {
+    fssm::metrics::Snapshot snapshot = m_controller->getMetrics();
+    auto gaugeValue = [&snapshot](const std::string& name) -> int64_t {
+        auto it = snapshot.gauges.find(name);
+        return it != snapshot.gauges.end() ? it->second : -1;
+    };
+    auto counterValue = [&snapshot](const std::string& name) -> uint64_t {
+        auto it = snapshot.counters.find(name);
+        return it != snapshot.counters.end() ? it->second : 0;
+    };
+
+    QString html = "<table cellspacing=\"0\" cellpadding=\"2\">";
+    auto addRow = [&html](const QString& label, const QString& value) {
+        html += "<tr><td>" + label + "</td><td>&nbsp;&nbsp;" + value + "</td></tr>";
+    };
+    addRow("<b>Last / p95</b>", "");
+    for (fssm::Game game: {fssm::Game::DSR, fssm::Game::DS3, fssm::Game::ER}) {
+        std::string gameName = game.toString();
+        addRow(QString("%1 load").arg(gameName.c_str()), formatLatency(snapshot, "load." + gameName));
+        addRow(QString("%1 parse").arg(gameName.c_str()), formatLatency(snapshot, "parse." + gameName));
+    }
+    // Application parses ER slot summaries and characters separately, never the full file
+    addRow("ER parse summary", formatLatency(snapshot, "parse.ER.summary"));
+    addRow("ER parse character", formatLatency(snapshot, "parse.ER.character"));
+    addRow("QuickSave", formatLatency(snapshot, "quicksave"));
+    addRow("QuickLoad", formatLatency(snapshot, "quickload"));
+
+    addRow("<b>Backups</b>", "");
+    for (fssm::Game game: {fssm::Game::DSR, fssm::Game::DS2_SOTFS, fssm::Game::DS3, fssm::Game::Sekiro, fssm::Game::ER}) {
+        std::string gameName = game.toString();
+        int64_t count = gaugeValue("backups.count." + gameName);
+        if (count < 0) continue;
+        // Size is not known until background computation finishes
+        int64_t bytes = gaugeValue("backups.bytes." + gameName);
+        QString size = bytes < 0 ? "-" : QString::number(static_cast<double>(bytes) / (1024.0 * 1024.0), 'f', 1);
+        addRow(gameName.c_str(), QString("%1 backups, %2 MB").arg(count).arg(size));
+    }
+
+    addRow("<b>Caches</b>", "");
+    addRow("Item images", formatHitRate(snapshot, "cache.pixmap"));
+    addRow("Character rows", formatHitRate(snapshot, "cache.characters"));
+
+    addRow("<b>Save watcher</b>", "");
+    addRow("Changes", QString("%1 of %2 checks")
+        .arg(counterValue("watcher.events"))
+        .arg(counterValue("watcher.polls")));
+    html += "</table>";
+    m_statsLabel->setText(html);
+}
+
+void DiagnosticsWidget::updateConfigInfo(const ConfigSettingsData& configData) {
+    m_tracingInput->setChecked(configData.tracingEnabled);
+};
+
+void DiagnosticsWidget::applyChanges(const ConfigSettingsData& configData, ConfigConfirmData& confirmData) {
+    if (m_tracingInput->isChecked() != configData.tracingEnabled) {
+        confirmData.tracingEnabled = m_tracingInput->isChecked();
+    }
+};
+
+void DiagnosticsWidget::onWriteTrace() {
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/fssm_trace.json";
+    QString path = QFileDialog::getSaveFileName(
+        this,
+        "Write trace",
+        defaultPath,
+        tr("Trace files (*.json);;All files (*.*)")
+    );
+    if (path.isEmpty()) return;
+    uint64_t spanCount = m_controller->getTraceSpanCount();
+    if (m_controller->writeTrace(path)) {
+        m_traceStatusLabel->setText(QString("Written %1 spans").arg(spanCount));
+    } else {
+        m_traceStatusLabel->setText("Failed to write trace");
+    }
+};
+
 SettingsWidget::SettingsWidget(Controller* controller, QWidget* parent): QWidget(parent), m_controller(controller) {
     m_configData = m_controller->getConfigSettingsData();
     QLabel* pathsLabel = new QLabel("Paths", this);
@@ -352,6 +503,10 @@ SettingsWidget::SettingsWidget(Controller* controller, QWidget* parent): QWidget
     autoBackupLabel->setObjectName("settings_header");
     m_autobackupWidget = new AutoBackupWidget(m_configData, this);
 
+    QLabel* diagnosticsLabel = new QLabel("Diagnostics", this);
+    diagnosticsLabel->setObjectName("settings_header");
+    m_diagnosticsWidget = new DiagnosticsWidget(m_controller, m_configData, this);
+
     QWidget* btnsWidget = new QWidget(this);
 
     QPushButton* saveBtn = new QPushButton("Save", btnsWidget);
@@ -376,6 +531,9 @@ SettingsWidget::SettingsWidget(Controller* controller, QWidget* parent): QWidget
     layout->addSpacing(10);
     layout->addWidget(autoBackupLabel, 0);
     layout->addWidget(m_autobackupWidget, 0);
+    layout->addSpacing(10);
+    layout->addWidget(diagnosticsLabel, 0);
+    layout->addWidget(m_diagnosticsWidget, 0);
     layout->addStretch(1);
     layout->addWidget(btnsWidget, 0);
 
@@ -388,6 +546,7 @@ void SettingsWidget::onSave() {
     m_pathsWidget->applyChanges(m_configData, confirmData);
     m_hotkeysWidget->applyChanges(m_configData, confirmData);
     m_autobackupWidget->applyChanges(m_configData, confirmData);
+    m_diagnosticsWidget->applyChanges(m_configData, confirmData);
     m_controller->saveConfigData(confirmData);
 }
 
@@ -396,4 +555,5 @@ void SettingsWidget::discardChanges() {
     m_pathsWidget->updateConfigInfo(m_configData);
     m_hotkeysWidget->updateConfigInfo(m_configData);
     m_autobackupWidget->updateConfigInfo(m_configData);
+    m_diagnosticsWidget->updateConfigInfo(m_configData);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QFuture>
 #include <QLineEdit>
+#include <QTimer>
 
 #include "Controller.h"
 #include "SquareButton.h"
@@ -84,6 +86,30 @@ private:
     FocusSpinBox* m_maxAutobackupInput;
 };
 
+class DiagnosticsWidget: public QWidget {
+    Q_OBJECT
+public:
+    explicit DiagnosticsWidget(Controller* controller, const ConfigSettingsData& configData, QWidget* parent);
+    ~DiagnosticsWidget() override;
+    void updateConfigInfo(const ConfigSettingsData& configData);
+    void applyChanges(const ConfigSettingsData& configData, ConfigConfirmData& confirmData);
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+private slots:
+    void onWriteTrace();
+    void refreshStats();
+private:
+    Controller* m_controller;
+    NiceCheckbox* m_tracingInput;
+    QLabel* m_traceStatusLabel;
+    // Stats are refreshed only while visible
+    QLabel* m_statsLabel;
+    QTimer* m_statsTimer;
+    // Backup sizes are computed in background each time diagnostics are shown
+    QFuture<void> m_backupSizesFuture;
+};
+
 class SettingsWidget: public QWidget {
     Q_OBJECT
 public:
@@ -98,6 +124,7 @@ private:
     SavePathInputsWidget* m_pathsWidget;
     HotkeysWidget* m_hotkeysWidget;
     AutoBackupWidget* m_autobackupWidget;
+    DiagnosticsWidget* m_diagnosticsWidget;
 
 private slots:
     void virtual onSave();
@@ -2,6 +2,14 @@
 
 #include <QStyle>
 
+#ifdef FSSM_USE_ASSET_PACK
+#include "AssetPack.h"
+
+bool inventoryResourcesAvailable() {
+    return AssetPack::instance()->isOpen();
+}
+#endif
+
 FocusSpinBox::FocusSpinBox(QWidget* parent): QSpinBox(parent) {
     setFocusPolicy(Qt::StrongFocus);
 };
@@ -8,7 +8,10 @@
 #include <QUuid>
 
 
-#ifdef FSSM_USE_INV_IMAGES
+#if defined(FSSM_USE_ASSET_PACK)
+    // Inventory images are available only if asset pack was found next to executable
+    bool inventoryResourcesAvailable();
+#elif defined(FSSM_USE_INV_IMAGES)
     inline bool inventoryResourcesAvailable() {return true;}
 #else
     inline bool inventoryResourcesAvailable() {return false;}